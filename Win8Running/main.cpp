@@ -13,9 +13,12 @@
 #include <QFileInfo>
 #include <LayerShellQt/window.h>
 #include <QTimer>
+#include <QElapsedTimer>
 
 #include <QStandardPaths>
 
+#include "icontheme.h"
+
 /* ---------------- Program Launcher ---------------- */
 
 class Launcher : public QObject {
@@ -167,6 +170,11 @@ private:
     QFileSystemWatcher watcher;
     QString iniPath;
 
+    // A missing icon usually belongs to a newly installed app; the index
+    // is re-stat'ed at most this often for one
+    static constexpr qint64 RevalidateIntervalMs = 10000;
+    QElapsedTimer lastRevalidate;
+
     void load() {
         QSettings ini(iniPath, QSettings::IniFormat);
          
@@ -204,58 +212,18 @@ private:
 
     QString resolveIcon(const QString &name)
     {
-        QString xdgDataHome = qEnvironmentVariable("XDG_DATA_HOME");
-        if (xdgDataHome.isEmpty())
-            xdgDataHome = QDir::homePath() + "/.local/share";
-
-        QStringList basePaths = {
-            xdgDataHome + "/icons/hicolor",
-            QDir::homePath() + "/.icons",
-            "/usr/share/icons/hicolor",
-            "/usr/share/icons/breeze/apps",
-            "/usr/share/pixmaps"
-        };
-
-        QStringList sizes = {
-            "scalable/apps",
-            "256x256/apps",
-            "128x128/apps",
-            "64x64/apps",
-            "48x48/apps",
-            "64",
-            "48"
-        };
-
-        for (const QString &base : basePaths) {
-
-            // 🔹 pixmaps: search directly, no size directories
-            if (base == "/usr/share/pixmaps") {
-                QString png = base + "/" + name + ".png";
-                if (QFile::exists(png))
-                    return QUrl::fromLocalFile(png).toString();
-
-                QString svg = base + "/" + name + ".svg";
-                if (QFile::exists(svg))
-                    return QUrl::fromLocalFile(svg).toString();
-
-                continue;
-            }
-
-            // 🔹 icon themes: search with sizes
-            for (const QString &size : sizes) {
-                QString path = base + "/" + size + "/" + name;
-
-                QString svg = path + ".svg";
-                if (QFile::exists(svg))
-                    return QUrl::fromLocalFile(svg).toString();
-
-                QString png = path + ".png";
-                if (QFile::exists(png))
-                    return QUrl::fromLocalFile(png).toString();
-            }
+        // Shared XDG theme index: follows the user's theme and Inherits=,
+        // answered from memory on every refresh
+        QString path = IconTheme::instance().lookup(name);
+        if (path.isEmpty() && !name.isEmpty()
+            && (!lastRevalidate.isValid() || lastRevalidate.hasExpired(RevalidateIntervalMs))) {
+            lastRevalidate.start();
+            IconTheme::instance().revalidate();
+            path = IconTheme::instance().lookup(name);
         }
-
-        return {};
+        if (path.isEmpty())
+            return {};
+        return QUrl::fromLocalFile(path).toString();
     }
 
 
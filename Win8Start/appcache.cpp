@@ -0,0 +1,271 @@
+#include "appcache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+// -----------------------------
+// On-disk layout (native endian, local cache only)
+// -----------------------------
+namespace {
+
+constexpr char Magic[8] = {'W', '8', 'A', 'P', 'P', 'S', '\0', '\0'};
+constexpr int KeySize = 32;    // md5 hex
+
+struct CacheHeader {
+    char magic[8];
+    quint32 version;
+    quint32 count;
+    quint32 recordsOffset;
+    quint32 stringsOffset;
+    quint32 stringsSize;       // UTF-16 code units
+    quint32 actionCount;       // action records, right after the entry records
+    char key[KeySize];
+};
+
+struct StrRef {
+    quint32 offset;            // into the string table, in code units
+    quint32 length;
+};
+
+enum RecordFlags : quint32 {
+    TerminalFlag = 1u << 0,
+    HiddenFlag   = 1u << 1     // only desktopFilePath is set (the desktop ID)
+};
+
+struct CacheRecord {
+    StrRef name;
+    StrRef genericName;
+    StrRef keywords;           // ';' separated
+    StrRef command;
+    StrRef icon;
+    StrRef desktopFilePath;
+    StrRef categories;         // ';' separated
+    StrRef tryExec;            // filtered against PATH when merged
+    StrRef workingDir;         // Path=
+    quint32 flags;
+    quint32 firstAction;       // into the action records
+    quint32 actionCount;
+    quint32 reserved;
+};
+
+struct ActionRecord {
+    StrRef id;
+    StrRef name;
+    StrRef exec;
+    StrRef icon;
+};
+
+static_assert(sizeof(CacheHeader) == 64, "cache header layout changed");
+static_assert(sizeof(CacheRecord) == 88, "cache record layout changed");
+static_assert(sizeof(ActionRecord) == 32, "cache action layout changed");
+
+} // namespace
+
+// -----------------------------
+// Key
+// -----------------------------
+QByteArray AppCache::segmentKey(const QString &dir) {
+    QCryptographicHash md5(QCryptographicHash::Md5);
+    md5.addData(dir.toUtf8());
+    md5.addData(QByteArray::number(QFileInfo(dir).lastModified().toMSecsSinceEpoch()));
+    return md5.result().toHex();
+}
+
+// -----------------------------
+// Load
+// -----------------------------
+bool AppCache::load(const QString &path, const QByteArray &key, AppSegment *segment) {
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly))
+        return false;
+
+    const qint64 size = f.size();
+    if (size < qint64(sizeof(CacheHeader)) || key.size() != KeySize)
+        return false;
+
+    uchar *base = f.map(0, size);
+    if (!base)
+        return false;
+
+    const auto *h = reinterpret_cast<const CacheHeader *>(base);
+    const quint64 recordsEnd = quint64(h->recordsOffset) + quint64(h->count) * sizeof(CacheRecord)
+                               + quint64(h->actionCount) * sizeof(ActionRecord);
+    const quint64 stringsEnd = quint64(h->stringsOffset) + quint64(h->stringsSize) * sizeof(char16_t);
+
+    const bool valid = std::memcmp(h->magic, Magic, sizeof(Magic)) == 0
+                       && h->version == Version
+                       && std::memcmp(h->key, key.constData(), KeySize) == 0
+                       && h->recordsOffset % alignof(CacheRecord) == 0
+                       && h->stringsOffset % alignof(char16_t) == 0
+                       && recordsEnd <= quint64(size)
+                       && stringsEnd <= quint64(size);
+
+    if (!valid) {
+        f.unmap(base);
+        return false;
+    }
+
+    const auto *records = reinterpret_cast<const CacheRecord *>(base + h->recordsOffset);
+    const auto *actions = reinterpret_cast<const ActionRecord *>(records + h->count);
+    const auto *strings = reinterpret_cast<const QChar *>(base + h->stringsOffset);
+    const quint32 stringsSize = h->stringsSize;
+    bool inBounds = true;
+
+    auto str = [&](const StrRef &ref) -> QString {
+        if (quint64(ref.offset) + ref.length > stringsSize) {
+            inBounds = false;
+            return QString();
+        }
+        return QString(strings + ref.offset, ref.length);
+    };
+
+    AppSegment result;
+    result.apps.reserve(h->count);
+
+    for (quint32 i = 0; i < h->count && inBounds; ++i) {
+        const CacheRecord &r = records[i];
+        if (r.flags & HiddenFlag) {
+            result.hiddenIds.append(str(r.desktopFilePath));
+            continue;
+        }
+
+        AppInfo app;
+        app.name = str(r.name);
+        app.genericName = str(r.genericName);
+        app.keywords = str(r.keywords).split(';', Qt::SkipEmptyParts);
+        app.command = str(r.command);
+        app.icon = str(r.icon);
+        app.desktopFilePath = str(r.desktopFilePath);
+        app.categories = str(r.categories).split(';', Qt::SkipEmptyParts);
+        app.tryExec = str(r.tryExec);
+        app.workingDir = str(r.workingDir);
+        app.terminal = r.flags & TerminalFlag;
+
+        if (quint64(r.firstAction) + r.actionCount > h->actionCount) {
+            inBounds = false;
+            break;
+        }
+        app.actions.reserve(r.actionCount);
+        for (quint32 a = r.firstAction; a < r.firstAction + r.actionCount; ++a) {
+            app.actions.append({str(actions[a].id), str(actions[a].name),
+                                str(actions[a].exec), str(actions[a].icon)});
+        }
+        result.apps.append(std::move(app));
+    }
+
+    f.unmap(base);
+
+    if (!inBounds)
+        return false;
+
+    *segment = std::move(result);
+    return true;
+}
+
+// -----------------------------
+// Save
+// -----------------------------
+bool AppCache::save(const QString &path, const QByteArray &key, const AppSegment &segment) {
+    if (key.size() != KeySize)
+        return false;
+
+    // Categories, icons and terminal commands repeat a lot; store each once
+    QString table;
+    QHash<QString, StrRef> interned;
+
+    auto intern = [&](const QString &s) -> StrRef {
+        if (s.isEmpty())
+            return {0, 0};
+        auto it = interned.constFind(s);
+        if (it != interned.constEnd())
+            return *it;
+        StrRef ref{quint32(table.size()), quint32(s.size())};
+        table.append(s);
+        interned.insert(s, ref);
+        return ref;
+    };
+
+    std::vector<CacheRecord> records;
+    std::vector<ActionRecord> actions;
+    records.reserve(segment.apps.size() + segment.hiddenIds.size());
+
+    for (const AppInfo &app : segment.apps) {
+        CacheRecord r{};
+        r.name = intern(app.name);
+        r.genericName = intern(app.genericName);
+        r.keywords = intern(app.keywords.join(';'));
+        r.command = intern(app.command);
+        r.icon = intern(app.icon);
+        r.desktopFilePath = intern(app.desktopFilePath);
+        r.categories = intern(app.categories.join(';'));
+        r.tryExec = intern(app.tryExec);
+        r.workingDir = intern(app.workingDir);
+        r.flags = app.terminal ? TerminalFlag : 0;
+        r.firstAction = quint32(actions.size());
+        r.actionCount = quint32(app.actions.size());
+        for (const DesktopAction &action : app.actions)
+            actions.push_back({intern(action.id), intern(action.name),
+                               intern(action.exec), intern(action.icon)});
+        records.push_back(r);
+    }
+
+    for (const QString &id : segment.hiddenIds) {
+        CacheRecord r{};
+        r.desktopFilePath = intern(id);
+        r.flags = HiddenFlag;
+        records.push_back(r);
+    }
+
+    CacheHeader h{};
+    std::memcpy(h.magic, Magic, sizeof(Magic));
+    h.version = Version;
+    h.count = quint32(records.size());
+    h.recordsOffset = sizeof(CacheHeader);
+    h.stringsOffset = quint32(sizeof(CacheHeader) + records.size() * sizeof(CacheRecord)
+                              + actions.size() * sizeof(ActionRecord));
+    h.stringsSize = quint32(table.size());
+    h.actionCount = quint32(actions.size());
+    std::memcpy(h.key, key.constData(), KeySize);
+
+    // Written to a temp file and renamed, so a reader that still has the
+    // old file mapped keeps a consistent view
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly))
+        return false;
+
+    f.write(reinterpret_cast<const char *>(&h), sizeof(h));
+    f.write(reinterpret_cast<const char *>(records.data()),
+            qint64(records.size() * sizeof(CacheRecord)));
+    f.write(reinterpret_cast<const char *>(actions.data()),
+            qint64(actions.size() * sizeof(ActionRecord)));
+    f.write(reinterpret_cast<const char *>(table.utf16()),
+            qint64(table.size()) * qint64(sizeof(char16_t)));
+
+    return f.commit();
+}
+
+// -----------------------------
+// Debug export
+// -----------------------------
+bool AppCache::exportJson(const QString &path, const QList<AppInfo> &apps) {
+    QJsonArray arr;
+    for (const AppInfo &app : apps)
+        arr.append(QJsonObject::fromVariantMap(appInfoToVariantMap(app)));
+
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly))
+        return false;
+    f.write(QJsonDocument(arr).toJson());
+    return f.commit();
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+#include "appindex.h"
+
+// ----------------------------
+// AppCache
+// ----------------------------
+// Versioned binary snapshot of one applications directory. The file is a
+// fixed header, one fixed-size record per entry and per desktop action,
+// and a deduplicated UTF-16 string table; it is mmap'd and read in
+// place, so a cold start fills AppModel without JSON parsing or a
+// QVariantMap per app.
+class AppCache {
+public:
+    static constexpr quint32 Version = 5;
+
+    // Segment key: directory path + mtime. Adding, removing or renaming an
+    // entry (which is how package managers replace files) bumps the
+    // directory mtime; in-place edits are caught by the live index instead.
+    // TryExec= is stored as written and checked against PATH on merge, so
+    // installing an executable leaves every segment valid.
+    static QByteArray segmentKey(const QString &dir);
+
+    // Returns false when the file is missing, corrupt, from another
+    // version or was written for a different key (32 bytes).
+    static bool load(const QString &path, const QByteArray &key, AppSegment *segment);
+    static bool save(const QString &path, const QByteArray &key, const AppSegment &segment);
+
+    // Human-readable copy of the same data, for debugging only
+    static bool exportJson(const QString &path, const QList<AppInfo> &apps);
+};
@@ -0,0 +1,548 @@
+#include "appindex.h"
+#include "desktopentry.h"
+#include "icontheme.h"
+#include "pathindex.h"
+#include "xdgdatadirs.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSocketNotifier>
+#include <QStandardPaths>
+#include <QTimer>
+#include <QtConcurrent>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <algorithm>
+#include <utility>
+
+// -----------------------------
+// AppInfo -> QVariantMap
+// -----------------------------
+QVariantMap appInfoToVariantMap(const AppInfo &app) {
+    QVariantMap m;
+    m["name"] = app.name;
+    m["genericName"] = app.genericName;
+    m["keywords"] = app.keywords;
+    m["command"] = app.command;
+    m["icon"] = app.icon;
+    m["desktopFilePath"] = app.desktopFilePath;
+    m["categories"] = app.categories;
+    m["terminal"] = app.terminal;
+
+    QVariantList actions;
+    for (const DesktopAction &action : app.actions) {
+        actions.append(QVariantMap{
+            {"id", action.id}, {"name", action.name}, {"exec", action.exec}, {"icon", action.icon}
+        });
+    }
+    m["actions"] = actions;
+    return m;
+}
+
+// -----------------------------
+// Constructor / Destructor
+// -----------------------------
+AppIndex::AppIndex(QObject *parent)
+: QObject(parent) {
+    // Package managers drop several files at once; handle them as one batch
+    m_debounce = new QTimer(this);
+    m_debounce->setSingleShot(true);
+    m_debounce->setInterval(250);
+    connect(m_debounce, &QTimer::timeout, this, &AppIndex::processPending);
+
+    startWatching();
+}
+
+AppIndex::~AppIndex() {
+    if (m_inotifyFd >= 0)
+        ::close(m_inotifyFd);
+}
+
+void AppIndex::setIconResolver(IconResolver resolver) {
+    m_resolveIcon = std::move(resolver);
+}
+
+QString AppIndex::resolveIcon(const QString &name) {
+    if (name.isEmpty())
+        return "qrc:/icons/placeholder.svg";
+
+    if (name.startsWith('/'))
+        return QFile::exists(name) ? "file://" + name : "qrc:/icons/placeholder.svg";
+
+    // Theme-aware lookup (no stat calls)
+    const QString path = IconTheme::instance().lookup(name);
+    return path.isEmpty() ? "qrc:/icons/placeholder.svg" : "file://" + path;
+}
+
+// -----------------------------
+// Directories
+// -----------------------------
+QStringList AppIndex::applicationDirs() {
+    static const QStringList dirs = [] {
+        QStringList out;
+        for (const QString &dataDir : xdgDataDirs())
+            out.append(dataDir + "/applications");
+        return out;
+    }();
+    return dirs;
+}
+
+// Top-level entries only, so the ID is the file name
+QString AppIndex::desktopId(const QString &desktopFilePath) {
+    return desktopFilePath.mid(desktopFilePath.lastIndexOf('/') + 1);
+}
+
+// -----------------------------
+// Single file parser
+// -----------------------------
+std::optional<AppInfo> AppIndex::parseDesktopFile(const QString &path,
+                                                  const IconResolver &resolveIcon) {
+    DesktopEntry entry;
+    if (!entry.load(path))
+        return std::nullopt;
+
+    const QByteArrayView group = DesktopEntry::MainGroup;
+    if (entry.boolean(group, "NoDisplay") || entry.boolean(group, "Hidden"))
+        return std::nullopt;
+
+    AppInfo app;
+    app.name = entry.localeString(group, "Name");
+    app.command = DesktopEntry::stripFieldCodes(entry.string(group, "Exec"));
+    if (app.name.isEmpty() || app.command.isEmpty())
+        return std::nullopt;
+
+    // Kept as written: whether it is installed changes with PATH, not
+    // with this file
+    app.tryExec = entry.string(group, "TryExec");
+    app.workingDir = entry.string(group, "Path");
+
+    app.genericName = entry.localeString(group, "GenericName");
+    app.keywords = entry.localeStringList(group, "Keywords");
+    app.categories = entry.stringList(group, "Categories");
+    app.terminal = entry.boolean(group, "Terminal");
+
+    const QString iconName = entry.string(group, "Icon");
+    app.icon = resolveIcon ? resolveIcon(iconName) : iconName;
+    app.desktopFilePath = path;
+
+    // Parsed here, once, so the context menu never opens the file
+    const QByteArrayView prefix = DesktopEntry::ActionGroupPrefix;
+    for (QByteArrayView actionGroup : entry.groups()) {
+        if (!actionGroup.startsWith(prefix))
+            continue;
+
+        DesktopAction action;
+        action.id = QString::fromUtf8(actionGroup.sliced(prefix.size()));
+        action.name = entry.localeString(actionGroup, "Name");
+        action.exec = DesktopEntry::stripFieldCodes(entry.string(actionGroup, "Exec"));
+        action.icon = entry.string(actionGroup, "Icon");
+        if (!action.icon.isEmpty() && resolveIcon)
+            action.icon = resolveIcon(action.icon);
+
+        if (!action.name.isEmpty() && !action.exec.isEmpty())
+            app.actions.append(std::move(action));
+    }
+    return app;
+}
+
+// -----------------------------
+// Scan pipeline
+// -----------------------------
+AppSegment AppIndex::scanDirectory(const QString &dirPath, const IconResolver &resolveIcon) {
+    AppSegment segment;
+
+    // 1. Enumerate
+    QDir dir(dirPath);
+    if (!dir.exists())
+        return segment;
+
+    QStringList paths;
+    const QStringList files = dir.entryList(QStringList() << "*.desktop", QDir::Files, QDir::Name);
+    for (const QString &file : files)
+        paths.append(dir.absoluteFilePath(file));
+
+    // 2. Parse in parallel; icons keep their raw theme name for now
+    QList<std::optional<AppInfo>> parsed =
+        QtConcurrent::blockingMapped<QList<std::optional<AppInfo>>>(
+            paths, [](const QString &path) { return parseDesktopFile(path, IconResolver()); });
+
+    segment.apps.reserve(parsed.size());
+    QSet<QString> iconNames;
+
+    for (int i = 0; i < parsed.size(); ++i) {
+        if (!parsed[i]) {
+            segment.hiddenIds.append(files[i]);
+            continue;
+        }
+        iconNames.insert(parsed[i]->icon);
+        for (const DesktopAction &action : parsed[i]->actions) {
+            if (!action.icon.isEmpty())
+                iconNames.insert(action.icon);
+        }
+        segment.apps.append(std::move(*parsed[i]));
+    }
+
+    // 3. Batched icon resolution: many apps share an icon name
+    if (resolveIcon) {
+        const QStringList names(iconNames.cbegin(), iconNames.cend());
+        const QStringList resolved = QtConcurrent::blockingMapped<QStringList>(
+            names, [&resolveIcon](const QString &name) { return resolveIcon(name); });
+
+        QHash<QString, QString> byName;
+        byName.reserve(names.size());
+        for (int i = 0; i < names.size(); ++i)
+            byName.insert(names[i], resolved[i]);
+
+        for (AppInfo &app : segment.apps) {
+            app.icon = byName.value(app.icon);
+            for (DesktopAction &action : app.actions) {
+                if (!action.icon.isEmpty())
+                    action.icon = byName.value(action.icon);
+            }
+        }
+    }
+
+    return segment;
+}
+
+QList<AppInfo> AppIndex::mergeSegments(QList<AppSegment> segments) {
+    QList<AppInfo> apps;
+    QSet<QString> claimed;
+
+    for (AppSegment &segment : segments) {
+        QSet<QString> ids(segment.hiddenIds.cbegin(), segment.hiddenIds.cend());
+
+        for (AppInfo &app : segment.apps) {
+            QString id = desktopId(app.desktopFilePath);
+            if (!claimed.contains(id) && isInstalled(app))
+                apps.append(std::move(app));
+            ids.insert(std::move(id));
+        }
+        claimed.unite(ids);
+    }
+
+    sortByName(apps);
+    return apps;
+}
+
+// Answered from the PATH index, not the disk
+bool AppIndex::isInstalled(const AppInfo &app) {
+    return app.tryExec.isEmpty() || PathIndex::instance().contains(app.tryExec);
+}
+
+void AppIndex::sortByName(QList<AppInfo> &apps) {
+    std::sort(apps.begin(), apps.end(), [](const AppInfo &a, const AppInfo &b) {
+        const int c = a.name.toLower().compare(b.name.toLower());
+        if (c != 0)
+            return c < 0;
+        return a.desktopFilePath < b.desktopFilePath;
+    });
+}
+
+// -----------------------------
+// Seeding
+// -----------------------------
+void AppIndex::reset(QList<AppSegment> segments, const QList<AppInfo> &apps) {
+    const QStringList dirs = applicationDirs();
+    m_segments.clear();
+    for (qsizetype i = 0; i < segments.size() && i < dirs.size(); ++i)
+        m_segments.insert(dirs[i], std::move(segments[i]));
+
+    m_entries.clear();
+    for (const AppInfo &app : apps)
+        m_entries.insert(desktopId(app.desktopFilePath), app);
+    m_seeded = true;
+
+    // Directories such as the flatpak exports appear with the first install
+    addWatches();
+
+    // Anything that changed while the full scan was running
+    if (!m_pending.isEmpty())
+        m_debounce->start();
+}
+
+void AppIndex::refilter() {
+    if (!m_seeded)
+        return;
+
+    const QHash<QString, AppInfo> previous = std::exchange(m_entries, visibleEntries());
+    int changed = 0;
+
+    for (auto it = previous.cbegin(); it != previous.cend(); ++it) {
+        auto now = m_entries.constFind(it.key());
+        if (now == m_entries.cend() || now->desktopFilePath != it->desktopFilePath) {
+            emit appRemoved(it->desktopFilePath);
+            ++changed;
+        }
+    }
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        auto before = previous.constFind(it.key());
+        if (before == previous.cend() || before->desktopFilePath != it->desktopFilePath) {
+            emit appAdded(*it);
+            ++changed;
+        }
+    }
+
+    qDebug() << "🔄 AppIndex refiltered for PATH:" << changed << "entries changed";
+}
+
+QList<AppInfo> AppIndex::apps() const {
+    return m_entries.values();
+}
+
+QList<DesktopAction> AppIndex::actions(const QString &desktopFilePath) const {
+    auto it = m_entries.constFind(desktopId(desktopFilePath));
+    if (it == m_entries.constEnd() || it->desktopFilePath != desktopFilePath)
+        return {};
+    return it->actions;
+}
+
+QString AppIndex::workingDir(const QString &desktopFilePath) const {
+    auto it = m_entries.constFind(desktopId(desktopFilePath));
+    if (it == m_entries.constEnd() || it->desktopFilePath != desktopFilePath)
+        return {};
+    return it->workingDir;
+}
+
+// -----------------------------
+// inotify
+// -----------------------------
+void AppIndex::startWatching() {
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd < 0) {
+        qWarning() << "AppIndex: inotify unavailable, falling back to rescans";
+        return;
+    }
+
+    // The user directory may not exist yet on a fresh account
+    QDir().mkpath(QStandardPaths::writableLocation(QStandardPaths::ApplicationsLocation));
+
+    addWatches();
+
+    if (m_watchDirs.isEmpty()) {
+        ::close(m_inotifyFd);
+        m_inotifyFd = -1;
+        return;
+    }
+
+    m_notifier = new QSocketNotifier(m_inotifyFd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &AppIndex::readEvents);
+}
+
+void AppIndex::addWatches() {
+    if (m_inotifyFd < 0)
+        return;
+
+    const uint32_t mask = IN_CREATE | IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM |
+                          IN_MOVED_TO | IN_ATTRIB;
+    QSet<QString> parents;
+
+    for (const QString &dir : applicationDirs()) {
+        if (QFileInfo(dir).isDir()) {
+            const int wd = inotify_add_watch(m_inotifyFd, QFile::encodeName(dir).constData(), mask);
+            if (wd < 0)
+                continue;
+            // Re-adding returns the same wd; a new one is a directory that
+            // appeared, possibly with entries already in it
+            const bool appeared = !m_watchDirs.contains(wd);
+            m_watchDirs.insert(wd, dir);
+            if (appeared && m_seeded) {
+                const QStringList files = QDir(dir).entryList({"*.desktop"}, QDir::Files);
+                for (const QString &file : files)
+                    m_pending.insert(dir + "/" + file);
+            }
+            continue;
+        }
+
+        // Not there yet (the flatpak exports come with the first install):
+        // watch the closest parent that is, for the directories on the way
+        QString parent = dir;
+        do {
+            parent = QFileInfo(parent).path();
+        } while (parent != "/" && !QFileInfo(parent).isDir());
+        parents.insert(parent);
+    }
+
+    for (auto it = m_parentWatches.begin(); it != m_parentWatches.end();) {
+        if (parents.contains(*it)) {
+            ++it;
+            continue;
+        }
+        inotify_rm_watch(m_inotifyFd, it.key());
+        it = m_parentWatches.erase(it);
+    }
+    for (const QString &parent : std::as_const(parents)) {
+        const int wd = inotify_add_watch(m_inotifyFd, QFile::encodeName(parent).constData(),
+                                         IN_CREATE | IN_MOVED_TO | IN_ONLYDIR);
+        if (wd >= 0)
+            m_parentWatches.insert(wd, parent);
+    }
+}
+
+void AppIndex::readEvents() {
+    alignas(struct inotify_event) char buf[4096];
+    bool dirsChanged = false;
+
+    for (;;) {
+        const ssize_t len = ::read(m_inotifyFd, buf, sizeof(buf));
+        if (len <= 0)
+            break;
+
+        for (const char *p = buf; p < buf + len;) {
+            const auto *ev = reinterpret_cast<const struct inotify_event *>(p);
+            p += sizeof(struct inotify_event) + ev->len;
+
+            if (ev->mask & IN_Q_OVERFLOW) {
+                qWarning() << "AppIndex: inotify queue overflow → full rescan";
+                m_pending.clear();
+                emit rescanRequired();
+                return;
+            }
+
+            // A watched directory went away, or one on the way to a missing
+            // one was created
+            if (ev->mask & IN_IGNORED) {
+                m_watchDirs.remove(ev->wd);
+                m_parentWatches.remove(ev->wd);
+                dirsChanged = true;
+                continue;
+            }
+            if (m_parentWatches.contains(ev->wd)) {
+                dirsChanged = dirsChanged || (ev->mask & IN_ISDIR);
+                continue;
+            }
+
+            if (ev->len == 0)
+                continue;
+
+            const QString dir = m_watchDirs.value(ev->wd);
+            const QString name = QFile::decodeName(ev->name);
+            if (dir.isEmpty() || !name.endsWith(".desktop"))
+                continue;
+
+            m_pending.insert(dir + "/" + name);
+        }
+    }
+
+    if (dirsChanged)
+        addWatches();
+
+    if (!m_pending.isEmpty() && m_seeded)
+        m_debounce->start();
+}
+
+// -----------------------------
+// Delta processing
+// -----------------------------
+// Same shadowing as mergeSegments(), over the segments in memory
+QHash<QString, AppInfo> AppIndex::visibleEntries() const {
+    QHash<QString, AppInfo> entries;
+    QSet<QString> claimed;
+
+    for (const QString &dir : applicationDirs()) {
+        auto segment = m_segments.constFind(dir);
+        if (segment == m_segments.cend())
+            continue;
+
+        QSet<QString> ids(segment->hiddenIds.cbegin(), segment->hiddenIds.cend());
+        for (const AppInfo &app : segment->apps) {
+            QString id = desktopId(app.desktopFilePath);
+            if (!claimed.contains(id) && isInstalled(app))
+                entries.insert(id, app);
+            ids.insert(std::move(id));
+        }
+        claimed.unite(ids);
+    }
+    return entries;
+}
+
+// The first directory that has the file decides, even when that entry is
+// hidden: a NoDisplay copy in ~/.local hides the system one.
+std::optional<AppInfo> AppIndex::resolveId(const QString &id) const {
+    for (const QString &dir : applicationDirs()) {
+        auto segment = m_segments.constFind(dir);
+        if (segment == m_segments.cend())
+            continue;
+        if (segment->hiddenIds.contains(id))
+            return std::nullopt;
+
+        const QString path = dir + "/" + id;
+        for (const AppInfo &app : segment->apps) {
+            if (app.desktopFilePath == path)
+                return isInstalled(app) ? std::optional<AppInfo>(app) : std::nullopt;
+        }
+    }
+    return std::nullopt;
+}
+
+// Bring the segment of the file's directory in line with the file
+void AppIndex::reparse(const QString &path) {
+    const QString id = desktopId(path);
+    AppSegment &segment = m_segments[path.left(path.lastIndexOf('/'))];
+
+    segment.hiddenIds.removeAll(id);
+    segment.apps.removeIf([&path](const AppInfo &app) { return app.desktopFilePath == path; });
+
+    if (!QFile::exists(path))
+        return;
+
+    if (std::optional<AppInfo> app = parseDesktopFile(path, m_resolveIcon))
+        segment.apps.append(std::move(*app));
+    else
+        segment.hiddenIds.append(id);
+}
+
+void AppIndex::processPending() {
+    if (!m_seeded)
+        return;
+
+    const QSet<QString> paths = std::exchange(m_pending, {});
+
+    // New packages usually bring their icons along
+    IconTheme::instance().revalidate();
+
+    QSet<QString> ids, dirs;
+    for (const QString &path : paths) {
+        reparse(path);
+        ids.insert(desktopId(path));
+        dirs.insert(path.left(path.lastIndexOf('/')));
+    }
+
+    for (const QString &id : ids) {
+        std::optional<AppInfo> app = resolveId(id);
+        auto it = m_entries.find(id);
+
+        if (!app) {
+            // Deleted, unreadable, now NoDisplay, not installed or shadowed
+            // by a hidden entry
+            if (it != m_entries.end()) {
+                const QString path = it->desktopFilePath;
+                m_entries.erase(it);
+                emit appRemoved(path);
+            }
+            continue;
+        }
+
+        if (it == m_entries.end()) {
+            m_entries.insert(id, *app);
+            emit appAdded(*app);
+        } else if (it->desktopFilePath != app->desktopFilePath) {
+            // An override appeared or went away; another file wins now
+            emit appRemoved(it->desktopFilePath);
+            *it = *app;
+            emit appAdded(*app);
+        } else {
+            *it = *app;
+            emit appChanged(*app);
+        }
+    }
+
+    qDebug() << "🔄 AppIndex updated:" << ids.size() << "entries in" << dirs.size() << "directories";
+
+    // Always reported, so cached segments also follow in-place edits that
+    // leave the directory mtime alone
+    emit indexChanged(QStringList(dirs.cbegin(), dirs.cend()));
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+
+#include <functional>
+#include <optional>
+
+class QSocketNotifier;
+class QTimer;
+
+// ----------------------------
+// DesktopAction struct
+// ----------------------------
+// One [Desktop Action <id>] group of an entry
+struct DesktopAction {
+    QString id;      // e.g. "NewWindow"
+    QString name;    // visible name
+    QString exec;    // Exec=
+    QString icon;    // Icon=, resolved like the app icon; empty when unset
+
+    bool operator==(const DesktopAction &) const = default;
+};
+
+// ----------------------------
+// AppInfo struct
+// ----------------------------
+struct AppInfo {
+    QString name;
+    QString genericName;
+    QStringList keywords;
+    QString command;
+    QString tryExec;    // TryExec=; checked against PATH when merged, not when parsed
+    QString workingDir; // Path=; empty for $HOME
+    QString icon;
+    QString desktopFilePath;
+    QStringList categories;
+    bool terminal = false;
+    QList<DesktopAction> actions;   // parsed with the entry, for the context menu
+};
+
+QVariantMap appInfoToVariantMap(const AppInfo &app);
+
+// ----------------------------
+// AppSegment
+// ----------------------------
+// Scan result of one applications directory. Hidden / NoDisplay entries,
+// and entries whose TryExec= is not on PATH, are not shown but still
+// shadow the same desktop ID in later directories.
+struct AppSegment {
+    QList<AppInfo> apps;
+    QStringList hiddenIds;
+};
+
+// ----------------------------
+// AppIndex
+// ----------------------------
+// In-memory table of the visible .desktop entries, kept up to date with
+// inotify. Only the files named by an event are re-parsed, and every
+// change is reported as a single added / changed / removed entry.
+//
+// Entries are keyed by desktop ID: the first directory in
+// applicationDirs() that has a file with that name wins. The segments of
+// all directories stay in memory, so a PATH change only filters them again.
+class AppIndex : public QObject {
+    Q_OBJECT
+public:
+    using IconResolver = std::function<QString(const QString &)>;
+
+    explicit AppIndex(QObject *parent = nullptr);
+    ~AppIndex();
+
+    void setIconResolver(IconResolver resolver);
+
+    // Icon= value as a URL for QML: absolute paths as they are, theme
+    // names from the in-memory IconTheme index, else the placeholder
+    static QString resolveIcon(const QString &name);
+
+    // Seed the table with a full scan: one segment per applicationDirs()
+    // entry, in that order, and `apps` merged from them. Events received
+    // before this are replayed on top of it.
+    void reset(QList<AppSegment> segments, const QList<AppInfo> &apps);
+
+    // Apply TryExec= again after PATH changed; no file is read
+    void refilter();
+
+    bool isWatching() const { return m_inotifyFd >= 0; }
+    bool isSeeded() const { return m_seeded; }
+    QList<AppInfo> apps() const;
+
+    // The entries of one directory as last parsed, for its on-disk segment
+    AppSegment segment(const QString &dir) const { return m_segments.value(dir); }
+
+    // Actions of an indexed entry; no file access
+    QList<DesktopAction> actions(const QString &desktopFilePath) const;
+
+    // Path= of an indexed entry, or empty; no file access
+    QString workingDir(const QString &desktopFilePath) const;
+
+    // $XDG_DATA_HOME and every $XDG_DATA_DIRS entry (plus the flatpak and
+    // snap exports), highest priority first
+    static QStringList applicationDirs();
+    static QString desktopId(const QString &desktopFilePath);
+    static std::optional<AppInfo> parseDesktopFile(const QString &path,
+                                                   const IconResolver &resolveIcon);
+
+    // Scan one directory: parse on all cores, then resolve each distinct
+    // icon name once.
+    static AppSegment scanDirectory(const QString &dir, const IconResolver &resolveIcon);
+
+    // Apply desktop ID shadowing over segments given in applicationDirs()
+    // order. The result is sorted and independent of scheduling.
+    static QList<AppInfo> mergeSegments(QList<AppSegment> segments);
+    static void sortByName(QList<AppInfo> &apps);
+
+    // TryExec= is unset or names an executable on PATH
+    static bool isInstalled(const AppInfo &app);
+
+signals:
+    void appAdded(const AppInfo &app);
+    void appChanged(const AppInfo &app);
+    void appRemoved(const QString &desktopFilePath);
+    void indexChanged(const QStringList &dirs);   // once per batch, with the directories touched
+    void rescanRequired();    // inotify queue overflowed
+
+private:
+    int m_inotifyFd = -1;
+    bool m_seeded = false;
+    QSocketNotifier *m_notifier = nullptr;
+    QTimer *m_debounce = nullptr;
+    QHash<int, QString> m_watchDirs;         // watch descriptor -> directory
+    QHash<int, QString> m_parentWatches;     // wd -> closest parent of a missing directory
+    QHash<QString, AppSegment> m_segments;   // directory -> parsed entries
+    QHash<QString, AppInfo> m_entries;       // desktop ID -> visible app
+    QSet<QString> m_pending;
+    IconResolver m_resolveIcon;
+
+    void startWatching();
+    void addWatches();
+    QHash<QString, AppInfo> visibleEntries() const;
+    std::optional<AppInfo> resolveId(const QString &id) const;
+    void reparse(const QString &path);
+    void readEvents();
+    void processPending();
+};
@@ -0,0 +1,140 @@
+// Compares DesktopEntry with the per-line readLine()/QRegularExpression
+// parser it replaced, over a directory of real .desktop files.
+//
+//   desktopentry-bench [corpus dir] [iterations]
+
+#include "desktopentry.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRegularExpression>
+#include <QTextStream>
+
+#include <cstdio>
+
+namespace {
+
+struct Parsed {
+    QString name;
+    QString genericName;
+    QStringList keywords;
+    QString command;
+    QString icon;
+    QStringList categories;
+    bool terminal = false;
+    bool noDisplay = false;
+};
+
+// The parser as it was copy-pasted through main.cpp
+Parsed parseLegacy(const QString &path) {
+    Parsed app;
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly | QIODevice::Text))
+        return app;
+
+    bool inMainSection = false;
+    while (!f.atEnd()) {
+        QString line = f.readLine().trimmed();
+
+        if (line.startsWith('[')) {
+            if (line == "[Desktop Entry]")
+                inMainSection = true;
+            else if (line.startsWith("[Desktop Action"))
+                break;
+            else
+                inMainSection = false;
+            continue;
+        }
+
+        if (!inMainSection) continue;
+
+        if (line.startsWith("Name="))
+            app.name = line.mid(5).trimmed();
+        else if (line.startsWith("Exec=")) {
+            app.command = line.mid(5).trimmed();
+            app.command.replace(QRegularExpression("%[UuFfDdNnVvMm]"), "");
+        }
+        else if (line.startsWith("Icon="))
+            app.icon = line.mid(5).trimmed();
+        else if (line.startsWith("Categories="))
+            app.categories = line.mid(11).split(';', Qt::SkipEmptyParts);
+        else if (line.startsWith("Terminal="))
+            app.terminal = (line.mid(9).trimmed().toLower() == "true");
+        else if (line.startsWith("NoDisplay=") && line.mid(10).trimmed().toLower() == "true")
+            app.noDisplay = true;
+        else if (line.startsWith("GenericName="))
+            app.genericName = line.mid(12).trimmed();
+        else if (line.startsWith("Keywords="))
+            app.keywords = line.mid(9).split(';', Qt::SkipEmptyParts);
+    }
+    return app;
+}
+
+Parsed parseDesktopEntry(const QString &path) {
+    Parsed app;
+    DesktopEntry entry;
+    if (!entry.load(path))
+        return app;
+
+    const QByteArrayView group = DesktopEntry::MainGroup;
+    app.name = entry.localeString(group, "Name");
+    app.genericName = entry.localeString(group, "GenericName");
+    app.keywords = entry.localeStringList(group, "Keywords");
+    app.command = DesktopEntry::stripFieldCodes(entry.string(group, "Exec"));
+    app.icon = entry.string(group, "Icon");
+    app.categories = entry.stringList(group, "Categories");
+    app.terminal = entry.boolean(group, "Terminal");
+    app.noDisplay = entry.boolean(group, "NoDisplay");
+    return app;
+}
+
+template <typename Fn>
+double nsPerFile(const QStringList &files, int iterations, Fn parse) {
+    qsizetype sink = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+        for (const QString &path : files)
+            sink += parse(path).name.size();
+    }
+    const qint64 ns = timer.nsecsElapsed();
+    if (sink < 0)
+        std::puts("");   // keep the results alive
+    return double(ns) / double(files.size() * qsizetype(iterations));
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+
+    const QString corpus = args.size() > 1 ? args[1] : QStringLiteral("/usr/share/applications");
+    const int iterations = args.size() > 2 ? qMax(1, args[2].toInt()) : 20;
+
+    QStringList files;
+    const QStringList names = QDir(corpus).entryList({"*.desktop"}, QDir::Files);
+    for (const QString &name : names)
+        files << corpus + "/" + name;
+
+    QTextStream out(stdout);
+    if (files.isEmpty()) {
+        out << "no .desktop files in " << corpus << "\n";
+        return 1;
+    }
+
+    // Warm the page cache so both runs measure parsing, not I/O
+    nsPerFile(files, 1, parseLegacy);
+
+    const double legacy = nsPerFile(files, iterations, parseLegacy);
+    const double tokenizer = nsPerFile(files, iterations, parseDesktopEntry);
+
+    out << "corpus:       " << corpus << " (" << files.size() << " files, "
+        << iterations << " iterations)\n";
+    out << "readLine:     " << qRound64(legacy) << " ns/file\n";
+    out << "DesktopEntry: " << qRound64(tokenizer) << " ns/file\n";
+    out << "speedup:      " << QString::number(legacy / tokenizer, 'f', 2) << "x\n";
+    return 0;
+}
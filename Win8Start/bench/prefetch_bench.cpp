@@ -0,0 +1,158 @@
+// Cold start of a real application with and without the hover prefetch.
+// Results go to stdout as JSON, a summary to stderr.
+//
+//   prefetch-bench [--runs 5] [--dwell 300] [--out file] program [args...]
+//
+// Each run evicts the program's files (the executable and its DT_NEEDED
+// closure, as Prefetcher sees them) from the page cache, then times
+// `program args` to exit: once straight away, once after the same
+// readahead the Start menu issues on hover followed by --dwell ms, the
+// time between resting on a tile and clicking it. Pass arguments that
+// make the program exit once loaded (the default is --version); the
+// dynamic loader maps every library either way.
+//
+// Eviction uses POSIX_FADV_DONTNEED and only drops pages nobody has
+// mapped, so close the application first. Click-to-window numbers for
+// real launches come from `Win8Start --launch-stats`.
+
+#include "prefetcher.h"
+#include "pathindex.h"
+#include "samples.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QTextStream>
+#include <QThread>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+// -----------------------------
+// Page cache
+// -----------------------------
+void evict(const QStringList &files) {
+    for (const QString &path : files) {
+        const int fd = open(QFile::encodeName(path).constData(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            continue;
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+}
+
+// Until the program exits
+qint64 timeStart(const QString &program, const QStringList &args) {
+    QElapsedTimer timer;
+    timer.start();
+
+    QProcess p;
+    p.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    p.setStandardOutputFile(QProcess::nullDevice());
+    p.start(program, args);
+    if (!p.waitForFinished(120000))
+        p.kill();
+    return timer.nsecsElapsed();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+
+    int runs = 5;
+    int dwellMs = 300;
+    QString outPath;
+    int i = 1;
+    for (; i + 1 < args.size() && args[i].startsWith("--"); i += 2) {
+        if (args[i] == "--runs")
+            runs = qMax(1, args[i + 1].toInt());
+        else if (args[i] == "--dwell")
+            dwellMs = qMax(0, args[i + 1].toInt());
+        else if (args[i] == "--out")
+            outPath = args[i + 1];
+    }
+
+    QTextStream err(stderr);
+    if (i >= args.size()) {
+        err << "usage: prefetch-bench [--runs N] [--dwell ms] [--out file] program [args...]\n";
+        return 2;
+    }
+
+    const QString program = PathIndex::instance().find(args[i]);
+    if (program.isEmpty()) {
+        err << "not found: " << args[i] << "\n";
+        return 1;
+    }
+    QStringList programArgs = args.mid(i + 1);
+    if (programArgs.isEmpty())
+        programArgs << "--version";
+
+    QElapsedTimer timer;
+    timer.start();
+    const QStringList files = Prefetcher::closure(program);
+    const double closureUs = double(timer.nsecsElapsed()) / 1000.0;
+
+    qint64 bytes = 0;
+    for (const QString &path : files)
+        bytes += QFileInfo(path).size();
+
+    const auto never = []() { return false; };
+    Samples cold, prefetched, readahead;
+    for (int run = 0; run < runs; ++run) {
+        evict(files);
+        cold.add(timeStart(program, programArgs));
+
+        evict(files);
+        timer.start();
+        Prefetcher::readahead(files, Prefetcher::BudgetBytes, never);
+        readahead.add(timer.nsecsElapsed());
+        QThread::msleep(ulong(dwellMs));
+        prefetched.add(timeStart(program, programArgs));
+    }
+
+    const QJsonObject report{
+        {"benchmark", "prefetch"},
+        {"timestamp", QDateTime::currentDateTimeUtc().toString(Qt::ISODate)},
+        {"program", program},
+        {"files", int(files.size())},
+        {"bytes", bytes},
+        {"runs", runs},
+        {"dwell_ms", dwellMs},
+        {"closure_us", closureUs},
+        {"readahead", readahead.json()},
+        {"cold_start", cold.json()},
+        {"prefetched_start", prefetched.json()}
+    };
+    const QByteArray json = QJsonDocument(report).toJson();
+
+    err << QFileInfo(program).fileName() << ": " << files.size() << " files, "
+        << bytes / (1024 * 1024) << " MiB; cold p50 "
+        << qRound(cold.percentile(0.5) / 1000) << " ms, prefetched p50 "
+        << qRound(prefetched.percentile(0.5) / 1000) << " ms\n";
+
+    if (outPath.isEmpty()) {
+        QTextStream(stdout) << json;
+    } else {
+        QFile out(outPath);
+        if (!out.open(QIODevice::WriteOnly)) {
+            err << "cannot write " << outPath << "\n";
+            return 1;
+        }
+        out.write(json);
+    }
+    return 0;
+}
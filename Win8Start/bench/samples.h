@@ -0,0 +1,36 @@
+#pragma once
+
+#include <QJsonObject>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// ----------------------------
+// Samples
+// ----------------------------
+// Timings of one measurement, reported as p50/p99/max in microseconds.
+// Shared by the benchmarks so their JSON reads the same.
+struct Samples {
+    std::vector<double> us;
+
+    void add(qint64 ns) { us.push_back(double(ns) / 1000.0); }
+
+    double percentile(double p) const {
+        if (us.empty())
+            return 0;
+        std::vector<double> sorted = us;
+        std::sort(sorted.begin(), sorted.end());
+        const size_t rank = size_t(std::ceil(p * double(sorted.size())));
+        return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    }
+
+    QJsonObject json() const {
+        return {
+            {"samples", int(us.size())},
+            {"p50_us", percentile(0.50)},
+            {"p99_us", percentile(0.99)},
+            {"max_us", percentile(1.0)}
+        };
+    }
+};
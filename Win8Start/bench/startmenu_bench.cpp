@@ -0,0 +1,341 @@
+// Start menu latency over synthetic application trees: cold directory
+// scans, warm segment cache loads, cache key checks, icon lookups,
+// per-keystroke search and the pinned tile store read at startup.
+// Results go to stdout as JSON, a summary to stderr.
+//
+//   startmenu-bench [--sizes 100,1000,5000,20000] [--runs 5] [--out file]
+//
+// Everything runs inside a temporary XDG tree ($HOME, data, config and
+// cache dirs are redirected), so the user's own caches are not touched.
+// "Cold" means without a segment cache; the page cache stays warm, as it
+// does for every Start menu open after the first.
+
+#include "appcache.h"
+#include "appindex.h"
+#include "icontheme.h"
+#include "samples.h"
+#include "searchindex.h"
+#include "tilestore.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr int IconCoverage = 9;    // of every 10 entries have a themed icon
+
+const char *const Words[] = {
+    "file", "text", "image", "video", "audio", "music", "photo", "mail", "web", "browser",
+    "office", "writer", "sheet", "slides", "draw", "paint", "code", "editor", "terminal",
+    "system", "monitor", "settings", "network", "manager", "player", "viewer", "reader",
+    "chat", "studio", "disk", "backup", "archive", "calendar", "contacts", "notes", "clock",
+    "weather", "maps", "game", "chess", "cards", "puzzle", "printer", "scanner", "camera",
+    "screen", "record", "capture", "font", "color", "password", "keyring", "remote",
+    "desktop", "shell", "python", "debugger", "profiler", "database", "server"
+};
+constexpr int WordCount = int(sizeof(Words) / sizeof(Words[0]));
+
+const char *const Categories[] = {
+    "Utility", "Development", "Network", "Office", "AudioVideo", "Game", "System", "Graphics"
+};
+
+QString capitalized(const char *word) {
+    QString s = QString::fromLatin1(word);
+    s[0] = s[0].toUpper();
+    return s;
+}
+
+// -----------------------------
+// Synthetic tree
+// -----------------------------
+struct Tree {
+    QString appsDir;
+    QStringList names;             // display names, for the search queries
+};
+
+void writeFile(const QString &path, const QByteArray &data) {
+    QFile f(path);
+    if (f.open(QIODevice::WriteOnly))
+        f.write(data);
+}
+
+// hicolor theme with one icon per app; written before IconTheme is first
+// used, since it indexes once per process
+void writeIconTheme(const QString &dataDir, int count) {
+    const QString theme = dataDir + "/icons/hicolor";
+    QDir().mkpath(theme + "/48x48/apps");
+    QDir().mkpath(theme + "/scalable/apps");
+    writeFile(theme + "/index.theme",
+              "[Icon Theme]\nName=Hicolor\nDirectories=48x48/apps,scalable/apps\n\n"
+              "[48x48/apps]\nSize=48\nType=Fixed\n\n"
+              "[scalable/apps]\nSize=48\nMinSize=16\nMaxSize=512\nType=Scalable\n");
+
+    for (int i = 0; i < count; ++i) {
+        const QString name = QStringLiteral("synthetic-app-%1").arg(i);
+        writeFile(theme + "/48x48/apps/" + name + ".png", QByteArray());
+        if (i % 4 == 0)
+            writeFile(theme + "/scalable/apps/" + name + ".svg", QByteArray());
+    }
+}
+
+Tree writeTree(const QString &dir, int count, QRandomGenerator &rng) {
+    Tree tree;
+    tree.appsDir = dir;
+    QDir().mkpath(dir);
+
+    for (int i = 0; i < count; ++i) {
+        const QString name = capitalized(Words[rng.bounded(WordCount)]) + " "
+                             + capitalized(Words[rng.bounded(WordCount)])
+                             + (i % 3 == 0 ? " " + capitalized(Words[rng.bounded(WordCount)]) : QString());
+        tree.names << name;
+
+        QByteArray d;
+        d += "[Desktop Entry]\nType=Application\nVersion=1.0\n";
+        d += "Name=" + name.toUtf8() + "\n";
+        d += "Name[de]=" + name.toUtf8() + " (de)\n";
+        d += "Name[fr]=" + name.toUtf8() + " (fr)\n";
+        d += "GenericName=" + capitalized(Words[rng.bounded(WordCount)]).toUtf8() + " Tool\n";
+        d += "Comment=Synthetic entry " + QByteArray::number(i) + " for the benchmark\n";
+        d += "Keywords=" + QByteArray(Words[rng.bounded(WordCount)]) + ";"
+             + Words[rng.bounded(WordCount)] + ";\n";
+        d += "Exec=synthetic-app-" + QByteArray::number(i) + " %U\n";
+        d += "Icon=" + (i % 10 < IconCoverage ? "synthetic-app-" + QByteArray::number(i)
+                                              : QByteArray("missing-icon")) + "\n";
+        d += "Categories=" + QByteArray(Categories[i % 8]) + ";"
+             + Categories[(i / 8) % 8] + ";\n";
+        d += "Terminal=" + QByteArray(i % 17 == 0 ? "true" : "false") + "\n";
+        if (i % 50 == 0)
+            d += "NoDisplay=true\n";
+        if (i % 5 == 0) {
+            d += "Actions=new-window;\n\n[Desktop Action new-window]\n";
+            d += "Name=New Window\nExec=synthetic-app-" + QByteArray::number(i) + " --new-window\n";
+        }
+        writeFile(dir + QStringLiteral("/synthetic-app-%1.desktop").arg(i), d);
+    }
+    return tree;
+}
+
+// -----------------------------
+// Statistics
+// -----------------------------
+template <typename Fn>
+Samples timeRuns(int runs, Fn fn) {
+    Samples s;
+    QElapsedTimer timer;
+    for (int i = 0; i < runs; ++i) {
+        timer.start();
+        fn();
+        s.add(timer.nsecsElapsed());
+    }
+    return s;
+}
+
+// Queries as typed: a prefix of a name, a word from inside one, and a
+// misspelled name, one keystroke at a time
+QStringList typedQueries(const QStringList &names, QRandomGenerator &rng, int count) {
+    QStringList queries;
+    for (int i = 0; i < count; ++i) {
+        const QString name = names[rng.bounded(int(names.size()))].toLower();
+        switch (i % 3) {
+        case 0:
+            queries << name;
+            break;
+        case 1:
+            queries << name.section(' ', 1);
+            break;
+        default: {
+            QString typo = name;
+            if (typo.size() > 4)
+                std::swap(typo[2], typo[3]);
+            queries << typo;
+        }
+        }
+    }
+    return queries;
+}
+
+// One keystroke as AppModel handles it: fold, refine from the previous
+// state, collect and sort
+Samples searchLatency(const SearchIndex &index, const QStringList &queries) {
+    Samples s;
+    QElapsedTimer timer;
+    for (const QString &query : queries) {
+        SearchIndex::State state;
+        for (int len = 1; len <= query.size(); ++len) {
+            timer.start();
+            const std::vector<SearchIndex::Match> matches =
+                index.search(SearchIndex::Query(query.left(len)), QString(), -1, &state);
+            s.add(timer.nsecsElapsed());
+            if (matches.size() > size_t(index.size()))
+                qFatal("impossible match count");
+        }
+    }
+    return s;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    QTemporaryDir root;
+    if (!root.isValid())
+        qFatal("cannot create a temporary directory");
+
+    // Before QCoreApplication, so QStandardPaths and IconTheme see them
+    const QString base = root.path();
+    qputenv("HOME", base.toUtf8());
+    qputenv("XDG_DATA_HOME", (base + "/data").toUtf8());
+    qputenv("XDG_DATA_DIRS", (base + "/share").toUtf8());
+    qputenv("XDG_CONFIG_HOME", (base + "/config").toUtf8());
+    qputenv("XDG_CACHE_HOME", (base + "/cache").toUtf8());
+    qputenv("WIN8_ICON_THEME", "hicolor");
+
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+
+    QList<int> sizes{100, 1000, 5000, 20000};
+    int runs = 5;
+    QString outPath;
+    for (int i = 1; i + 1 < args.size(); i += 2) {
+        if (args[i] == "--sizes") {
+            sizes.clear();
+            for (const QString &s : args[i + 1].split(',', Qt::SkipEmptyParts))
+                sizes << qMax(1, s.toInt());
+        } else if (args[i] == "--runs") {
+            runs = qMax(1, args[i + 1].toInt());
+        } else if (args[i] == "--out") {
+            outPath = args[i + 1];
+        }
+    }
+
+    QTextStream err(stderr);
+    QRandomGenerator rng(0x57384445);    // fixed, so runs are comparable
+
+    const int maxSize = *std::max_element(sizes.cbegin(), sizes.cend());
+    writeIconTheme(base + "/share", maxSize);
+
+    QElapsedTimer timer;
+    timer.start();
+    IconTheme::instance();
+    const double iconIndexUs = double(timer.nsecsElapsed()) / 1000.0;
+
+    QJsonArray results;
+    for (int size : sizes) {
+        const Tree tree = writeTree(QStringLiteral("%1/trees/%2/applications").arg(base).arg(size),
+                                    size, rng);
+        const QString cachePath = QStringLiteral("%1/cache/segment-%2.bin").arg(base).arg(size);
+        QDir().mkpath(base + "/cache");
+
+        // Cold: parse every file, resolve icons, merge, write the segment
+        AppSegment segment;
+        const Samples coldScan = timeRuns(runs, [&]() {
+            const QByteArray key = AppCache::segmentKey(tree.appsDir);
+            segment = AppIndex::scanDirectory(tree.appsDir, &AppIndex::resolveIcon);
+            AppIndex::mergeSegments({segment});
+            AppCache::save(cachePath, key, segment);
+        });
+
+        // Warm: key check, mmap the segment, merge
+        const Samples warmLoad = timeRuns(runs, [&]() {
+            AppSegment cached;
+            if (!AppCache::load(cachePath, AppCache::segmentKey(tree.appsDir), &cached))
+                qFatal("segment cache did not validate");
+            AppIndex::mergeSegments({cached});
+        });
+
+        const Samples keyCheck = timeRuns(runs * 100, [&]() { AppCache::segmentKey(tree.appsDir); });
+
+        const QList<AppInfo> apps = AppIndex::mergeSegments({segment});
+
+        Samples iconLookup;
+        for (int i = 0; i < size; ++i) {
+            const QString name = i % 10 < IconCoverage
+                                     ? QStringLiteral("synthetic-app-%1").arg(i)
+                                     : QStringLiteral("missing-icon");
+            timer.start();
+            AppIndex::resolveIcon(name);
+            iconLookup.add(timer.nsecsElapsed());
+        }
+
+        SearchIndex index;
+        const Samples indexBuild = timeRuns(runs, [&]() { index.build(apps); });
+        const Samples keystroke = searchLatency(index, typedQueries(tree.names, rng, 60));
+
+        // One pinned tile per app, read as TileModel does before the first frame
+        const QString tilePath = QStringLiteral("%1/config/tiles-%2.bin").arg(base).arg(size);
+        {
+            QList<Tile> tiles;
+            for (qsizetype i = 0; i < apps.size(); ++i) {
+                Tile t;
+                t.name = apps[i].name;
+                t.icon = apps[i].icon;
+                t.desktopFile = apps[i].desktopFilePath;
+                t.command = apps[i].command;
+                t.modelX = double(i / 6) * 100;
+                t.modelY = double(i % 6) * 100;
+                t.size = "medium";
+                tiles << t;
+            }
+            TileStore store(tilePath);
+            store.save(tiles);
+        }
+        const Samples tileLoad = timeRuns(runs, [&]() {
+            TileStore store(tilePath);
+            if (store.load().size() != apps.size())
+                qFatal("tile store did not round-trip");
+        });
+
+        err << size << " apps (" << apps.size() << " visible): cold scan "
+            << qRound64(coldScan.percentile(0.5) / 1000) << " ms, warm load "
+            << qRound64(warmLoad.percentile(0.5) / 1000) << " ms, keystroke p50/p99 "
+            << qRound64(keystroke.percentile(0.5)) << "/" << qRound64(keystroke.percentile(0.99))
+            << " us, tile store load " << qRound64(tileLoad.percentile(0.5)) << " us\n";
+        err.flush();
+
+        results.append(QJsonObject{
+            {"entries", size},
+            {"visible", int(apps.size())},
+            {"cold_scan", coldScan.json()},
+            {"warm_cache_load", warmLoad.json()},
+            {"cache_key_check", keyCheck.json()},
+            {"icon_lookup", iconLookup.json()},
+            {"search_index_build", indexBuild.json()},
+            {"search_keystroke", keystroke.json()},
+            {"tile_store_load", tileLoad.json()}
+        });
+    }
+
+    const QJsonObject report{
+        {"benchmark", "startmenu"},
+        {"timestamp", QDateTime::currentDateTimeUtc().toString(Qt::ISODate)},
+        {"runs", runs},
+        {"icon_index_build_us", iconIndexUs},
+        {"results", results}
+    };
+    const QByteArray json = QJsonDocument(report).toJson();
+
+    if (outPath.isEmpty()) {
+        QTextStream(stdout) << json;
+    } else {
+        QFile out(outPath);
+        if (!out.open(QIODevice::WriteOnly)) {
+            err << "cannot write " << outPath << "\n";
+            return 1;
+        }
+        out.write(json);
+    }
+    return 0;
+}
@@ -0,0 +1,309 @@
+#include "desktopentry.h"
+
+#include <QFile>
+
+#include <array>
+#include <cstring>
+
+namespace {
+
+bool equals(QByteArrayView a, QByteArrayView b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), size_t(a.size())) == 0;
+}
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+QByteArrayView trimmed(QByteArrayView v) {
+    qsizetype b = 0, e = v.size();
+    while (b < e && isSpace(v[b])) ++b;
+    while (e > b && isSpace(v[e - 1])) --e;
+    return v.sliced(b, e - b);
+}
+
+// LC_ALL / LC_MESSAGES / LANG as lang_COUNTRY@MODIFIER, lang_COUNTRY,
+// lang@MODIFIER, lang (desktop entry spec, "Localized values for keys")
+const QList<QByteArray> &localeCandidates() {
+    static const QList<QByteArray> candidates = [] {
+        QByteArray lc = qgetenv("LC_ALL");
+        if (lc.isEmpty()) lc = qgetenv("LC_MESSAGES");
+        if (lc.isEmpty()) lc = qgetenv("LANG");
+
+        QList<QByteArray> out;
+        if (lc.isEmpty() || lc == "C" || lc == "POSIX")
+            return out;
+
+        QByteArray modifier;
+        const int at = lc.indexOf('@');
+        if (at >= 0) {
+            modifier = lc.mid(at + 1);
+            lc.truncate(at);
+        }
+        const int dot = lc.indexOf('.');
+        if (dot >= 0)
+            lc.truncate(dot);
+
+        QByteArray lang = lc, country;
+        const int us = lc.indexOf('_');
+        if (us >= 0) {
+            lang = lc.left(us);
+            country = lc.mid(us + 1);
+        }
+
+        if (!country.isEmpty() && !modifier.isEmpty())
+            out << lang + '_' + country + '@' + modifier;
+        if (!country.isEmpty())
+            out << lang + '_' + country;
+        if (!modifier.isEmpty())
+            out << lang + '@' + modifier;
+        out << lang;
+        return out;
+    }();
+    return candidates;
+}
+
+// Field codes that are removed from Exec lines
+constexpr std::array<bool, 128> fieldCodeTable() {
+    std::array<bool, 128> t{};
+    for (char c : "fFuUdDnNvVmick")
+        if (c) t[size_t(c)] = true;
+    return t;
+}
+constexpr std::array<bool, 128> FieldCodes = fieldCodeTable();
+
+} // namespace
+
+// -----------------------------
+// Loading / tokenizing
+// -----------------------------
+bool DesktopEntry::load(const QString &path) {
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly))
+        return false;
+    parse(f.readAll());
+    return true;
+}
+
+void DesktopEntry::parse(QByteArray data) {
+    m_data = std::move(data);
+    m_entries.clear();
+    m_groups.clear();
+    m_entries.reserve(64);
+
+    const char *p = m_data.constData();
+    const char *end = p + m_data.size();
+
+    while (p < end) {
+        const char *nl = static_cast<const char *>(std::memchr(p, '\n', size_t(end - p)));
+        if (!nl) nl = end;
+        const QByteArrayView line = trimmed(QByteArrayView(p, nl - p));
+        p = nl + 1;
+
+        if (line.isEmpty() || line[0] == '#')
+            continue;
+
+        if (line[0] == '[') {
+            if (line.back() != ']')
+                continue;
+            if (!m_groups.empty())
+                m_groups.back().end = int(m_entries.size());
+            const int at = int(m_entries.size());
+            m_groups.push_back({line.sliced(1, line.size() - 2), at, at});
+            continue;
+        }
+
+        // Key/value pairs before the first group are not allowed
+        if (m_groups.empty())
+            continue;
+
+        const qsizetype eq = line.indexOf('=');
+        if (eq <= 0)
+            continue;
+
+        QByteArrayView key = trimmed(line.first(eq));
+        QByteArrayView locale;
+        const QByteArrayView value = trimmed(line.sliced(eq + 1));
+
+        const qsizetype bracket = key.indexOf('[');
+        if (bracket > 0 && key.back() == ']') {
+            locale = key.sliced(bracket + 1, key.size() - bracket - 2);
+            key = key.first(bracket);
+        }
+
+        m_entries.push_back({key, locale, value});
+    }
+
+    if (!m_groups.empty())
+        m_groups.back().end = int(m_entries.size());
+}
+
+// -----------------------------
+// Groups
+// -----------------------------
+const DesktopEntry::Group *DesktopEntry::findGroup(QByteArrayView name) const {
+    for (const Group &g : m_groups) {
+        if (equals(g.name, name))
+            return &g;
+    }
+    return nullptr;
+}
+
+bool DesktopEntry::hasGroup(QByteArrayView group) const {
+    return findGroup(group) != nullptr;
+}
+
+QList<QByteArrayView> DesktopEntry::groups() const {
+    QList<QByteArrayView> out;
+    out.reserve(qsizetype(m_groups.size()));
+    for (const Group &g : m_groups)
+        out.append(g.name);
+    return out;
+}
+
+// -----------------------------
+// Values
+// -----------------------------
+QByteArrayView DesktopEntry::rawValue(QByteArrayView group, QByteArrayView key, bool localized) const {
+    const Group *g = findGroup(group);
+    if (!g)
+        return {};
+
+    const QList<QByteArray> &candidates = localeCandidates();
+    const qsizetype unlocalizedRank = candidates.size();
+    qsizetype bestRank = unlocalizedRank + 1;
+    QByteArrayView best;
+    bool found = false;
+
+    for (int i = g->begin; i < g->end; ++i) {
+        const Entry &e = m_entries[size_t(i)];
+        if (!equals(e.key, key))
+            continue;
+
+        qsizetype rank = unlocalizedRank;
+        if (!e.locale.isEmpty()) {
+            if (!localized)
+                continue;
+            rank = -1;
+            for (qsizetype c = 0; c < candidates.size(); ++c) {
+                if (equals(e.locale, candidates[c])) {
+                    rank = c;
+                    break;
+                }
+            }
+            if (rank < 0)
+                continue;
+        }
+
+        if (rank < bestRank) {
+            bestRank = rank;
+            best = e.value;
+            found = true;
+            if (rank == 0)
+                break;
+        }
+    }
+
+    return found ? best : QByteArrayView();
+}
+
+QString DesktopEntry::string(QByteArrayView group, QByteArrayView key) const {
+    return unescape(rawValue(group, key, false));
+}
+
+QString DesktopEntry::localeString(QByteArrayView group, QByteArrayView key) const {
+    return unescape(rawValue(group, key, true));
+}
+
+QStringList DesktopEntry::stringList(QByteArrayView group, QByteArrayView key) const {
+    return splitList(rawValue(group, key, false));
+}
+
+QStringList DesktopEntry::localeStringList(QByteArrayView group, QByteArrayView key) const {
+    return splitList(rawValue(group, key, true));
+}
+
+bool DesktopEntry::boolean(QByteArrayView group, QByteArrayView key, bool defaultValue) const {
+    const QByteArrayView v = rawValue(group, key, false);
+    if (v.isEmpty())
+        return defaultValue;
+    return equals(v, "true") || equals(v, "True") || equals(v, "1");
+}
+
+// -----------------------------
+// Escapes
+// -----------------------------
+QString DesktopEntry::unescape(QByteArrayView raw) {
+    if (raw.indexOf('\\') < 0)
+        return QString::fromUtf8(raw);
+
+    QByteArray out;
+    out.reserve(raw.size());
+    for (qsizetype i = 0; i < raw.size(); ++i) {
+        const char c = raw[i];
+        if (c != '\\' || i + 1 == raw.size()) {
+            out.append(c);
+            continue;
+        }
+        switch (raw[++i]) {
+            case 's':  out.append(' ');  break;
+            case 'n':  out.append('\n'); break;
+            case 't':  out.append('\t'); break;
+            case 'r':  out.append('\r'); break;
+            case '\\': out.append('\\'); break;
+            default:   out.append('\\').append(raw[i]); break;
+        }
+    }
+    return QString::fromUtf8(out);
+}
+
+QStringList DesktopEntry::splitList(QByteArrayView raw) {
+    QStringList out;
+    qsizetype start = 0;
+    for (qsizetype i = 0; i <= raw.size(); ++i) {
+        const bool atEnd = i == raw.size();
+        if (!atEnd && raw[i] == '\\') {
+            ++i;   // skip the escaped character, including \;
+            continue;
+        }
+        if (!atEnd && raw[i] != ';')
+            continue;
+
+        const QByteArrayView part = raw.sliced(start, i - start);
+        if (!part.isEmpty()) {
+            QString s = unescape(part);
+            s.replace(QLatin1String("\\;"), QLatin1String(";"));
+            out.append(s);
+        }
+        start = i + 1;
+    }
+    return out;
+}
+
+// -----------------------------
+// Exec field codes
+// -----------------------------
+QString DesktopEntry::stripFieldCodes(const QString &exec) {
+    if (!exec.contains('%'))
+        return exec.trimmed();
+
+    QString out;
+    out.reserve(exec.size());
+    for (qsizetype i = 0; i < exec.size(); ++i) {
+        const QChar c = exec[i];
+        if (c != '%' || i + 1 == exec.size()) {
+            out.append(c);
+            continue;
+        }
+        const char16_t next = exec[i + 1].unicode();
+        if (next == '%') {
+            out.append('%');
+            ++i;
+        } else if (next < FieldCodes.size() && FieldCodes[next]) {
+            ++i;
+        } else {
+            out.append(c);
+        }
+    }
+    return out.trimmed();
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <vector>
+
+// ----------------------------
+// DesktopEntry
+// ----------------------------
+// Freedesktop .desktop file reader. The file is read into one buffer and
+// tokenized in a single pass into views over that buffer; strings are
+// only decoded (and unescaped) for the keys that are actually asked for.
+// All groups are kept, and Key[locale] variants are matched against the
+// LC_ALL / LC_MESSAGES / LANG locale.
+class DesktopEntry {
+public:
+    static constexpr QByteArrayView MainGroup = "Desktop Entry";
+    static constexpr QByteArrayView ActionGroupPrefix = "Desktop Action ";
+
+    bool load(const QString &path);
+    void parse(QByteArray data);
+
+    bool hasGroup(QByteArrayView group) const;
+    QList<QByteArrayView> groups() const;      // in file order
+
+    QString string(QByteArrayView group, QByteArrayView key) const;
+    QString localeString(QByteArrayView group, QByteArrayView key) const;
+    QStringList stringList(QByteArrayView group, QByteArrayView key) const;
+    QStringList localeStringList(QByteArrayView group, QByteArrayView key) const;
+    bool boolean(QByteArrayView group, QByteArrayView key, bool defaultValue = false) const;
+
+    // Drop %f %F %u %U %i %c %k and the deprecated codes from an Exec line,
+    // turning %% into %. Precomputed table, no regex.
+    static QString stripFieldCodes(const QString &exec);
+
+private:
+    struct Entry {
+        QByteArrayView key;
+        QByteArrayView locale;     // empty for the unlocalized key
+        QByteArrayView value;      // raw, still escaped
+    };
+
+    struct Group {
+        QByteArrayView name;
+        int begin;                 // range in m_entries
+        int end;
+    };
+
+    QByteArray m_data;
+    std::vector<Entry> m_entries;
+    std::vector<Group> m_groups;
+
+    const Group *findGroup(QByteArrayView name) const;
+    QByteArrayView rawValue(QByteArrayView group, QByteArrayView key, bool localized) const;
+
+    static QString unescape(QByteArrayView raw);
+    static QStringList splitList(QByteArrayView raw);
+};
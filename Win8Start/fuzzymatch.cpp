@@ -0,0 +1,185 @@
+#include "fuzzymatch.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace {
+
+// fzf's scoring constants (algo v1)
+constexpr int ScoreMatch = 16;
+constexpr int ScoreGapStart = -3;
+constexpr int ScoreGapExtension = -1;
+constexpr int BonusBoundary = ScoreMatch / 2;
+constexpr int BonusConsecutive = -(ScoreGapStart + ScoreGapExtension);
+constexpr int BonusFirstCharMultiplier = 2;
+
+bool isSeparator(QChar c) {
+    return c.isSpace() || c == '-' || c == '_' || c == '.' || c == '/' || c == ':';
+}
+
+} // namespace
+
+// -----------------------------
+// Pattern tables
+// -----------------------------
+FuzzyMatcher::FuzzyMatcher(const QString &foldedPattern)
+: m_pattern(foldedPattern) {
+    m_mask = charMask(m_pattern);
+    m_maxTypos = maxTyposFor(m_pattern.size());
+
+    const int m = int(std::min<qsizetype>(m_pattern.size(), MaxPatternLength));
+    for (int i = 0; i < m; ++i) {
+        const char16_t c = m_pattern[i].unicode();
+        const quint64 bit = quint64(1) << i;
+        if (c < m_peqAscii.size()) {
+            m_peqAscii[c] |= bit;
+            continue;
+        }
+        auto it = std::find_if(m_peqOther.begin(), m_peqOther.end(),
+                               [c](const auto &e) { return e.first == c; });
+        if (it != m_peqOther.end())
+            it->second |= bit;
+        else
+            m_peqOther.emplace_back(c, bit);
+    }
+}
+
+int FuzzyMatcher::maxTyposFor(qsizetype length) {
+    if (length < 4 || length > MaxPatternLength)
+        return 0;
+    return length < 8 ? 1 : 2;
+}
+
+quint64 FuzzyMatcher::peq(char16_t c) const {
+    if (c < m_peqAscii.size())
+        return m_peqAscii[c];
+    for (const auto &e : m_peqOther) {
+        if (e.first == c)
+            return e.second;
+    }
+    return 0;
+}
+
+// a-z and 0-9 get a bit each, other ASCII shares the next 27, and
+// everything else the top bit
+quint64 FuzzyMatcher::charMask(QStringView text) {
+    quint64 mask = 0;
+    for (QChar ch : text) {
+        const char16_t c = ch.unicode();
+        int bit;
+        if (c >= 'a' && c <= 'z')
+            bit = c - 'a';
+        else if (c >= '0' && c <= '9')
+            bit = 26 + (c - '0');
+        else if (c < 128)
+            bit = 36 + c % 27;
+        else
+            bit = 63;
+        mask |= quint64(1) << bit;
+    }
+    return mask;
+}
+
+// -----------------------------
+// Subsequence (fzf v1)
+// -----------------------------
+int FuzzyMatcher::subsequence(QStringView text, quint64 textMask) const {
+    const qsizetype m = m_pattern.size();
+    const qsizetype n = text.size();
+    if (m == 0 || m > n || (m_mask & ~textMask))
+        return -1;
+
+    // Forward: the earliest position where the whole pattern has been seen
+    qsizetype pi = 0, end = -1;
+    for (qsizetype i = 0; i < n; ++i) {
+        if (text[i] == m_pattern[pi] && ++pi == m) {
+            end = i + 1;
+            break;
+        }
+    }
+    if (end < 0)
+        return -1;
+
+    // Backward from there: the latest start, i.e. the shortest window
+    qsizetype start = 0;
+    pi = m - 1;
+    for (qsizetype i = end - 1; i >= 0; --i) {
+        if (text[i] == m_pattern[pi] && pi-- == 0) {
+            start = i;
+            break;
+        }
+    }
+
+    int score = 0;
+    int consecutive = 0;
+    bool inGap = false;
+    pi = 0;
+
+    for (qsizetype i = start; i < end && pi < m; ++i) {
+        if (text[i] != m_pattern[pi]) {
+            score += inGap ? ScoreGapExtension : ScoreGapStart;
+            inGap = true;
+            consecutive = 0;
+            continue;
+        }
+
+        int bonus = (i == 0 || isSeparator(text[i - 1])) ? BonusBoundary : 0;
+        if (consecutive > 0)
+            bonus = std::max(bonus, BonusConsecutive);
+        if (pi == 0)
+            bonus *= BonusFirstCharMultiplier;
+
+        score += ScoreMatch + bonus;
+        ++consecutive;
+        inGap = false;
+        ++pi;
+    }
+
+    return score;
+}
+
+// -----------------------------
+// Bounded edit distance (Myers 1999, Hyyrö's formulation)
+// -----------------------------
+int FuzzyMatcher::editDistance(QStringView text, quint64 textMask) const {
+    const int m = int(m_pattern.size());
+    if (m_maxTypos == 0)
+        return m == 0 ? 0 : 1;
+
+    // Each pattern character that never occurs in the text costs an edit
+    if (std::popcount(m_mask & ~textMask) > m_maxTypos)
+        return m_maxTypos + 1;
+
+    const quint64 last = quint64(1) << (m - 1);
+    const quint64 all = m == 64 ? ~quint64(0) : (last << 1) - 1;
+
+    quint64 pv = all;
+    quint64 mv = 0;
+    int score = m;
+    int best = m;
+
+    for (QChar ch : text) {
+        const quint64 eq = peq(ch.unicode());
+        const quint64 xv = eq | mv;
+        const quint64 xh = (((eq & pv) + pv) ^ pv) | eq;
+        quint64 ph = mv | ~(xh | pv);
+        quint64 mh = pv & xh;
+
+        if (ph & last)
+            ++score;
+        else if (mh & last)
+            --score;
+
+        // Nothing is shifted in: a match may start anywhere in the text
+        ph <<= 1;
+        mh <<= 1;
+        pv = (mh | ~(xv | ph)) & all;
+        mv = ph & xv;
+
+        best = std::min(best, score);
+        if (best == 0)
+            break;
+    }
+
+    return std::min(best, m_maxTypos + 1);
+}
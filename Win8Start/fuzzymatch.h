@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QString>
+#include <QStringView>
+
+#include <array>
+#include <utility>
+#include <vector>
+
+// ----------------------------
+// FuzzyMatcher
+// ----------------------------
+// Typo-tolerant matching of one case-folded query against many fields:
+//
+//  - subsequence(): fzf-style scoring of the shortest window that holds
+//    the query as a subsequence ("frfx" in "firefox"), with bonuses for
+//    word boundaries and consecutive characters and penalties for gaps.
+//  - editDistance(): bit-parallel Myers / Hyyrö, the smallest number of
+//    edits between the query and any substring of the text
+//    ("libreofice" in "libreoffice"). 64 DP cells per step.
+//
+// The pattern tables are built once per query; fields carry a 64-bit
+// character mask so most non-matches are rejected with one AND.
+class FuzzyMatcher {
+public:
+    static constexpr int MaxPatternLength = 64;   // one machine word for Myers
+    static constexpr int MinLength = 3;           // shorter queries match too much
+
+    explicit FuzzyMatcher(const QString &foldedPattern = QString());
+
+    const QString &pattern() const { return m_pattern; }
+    bool isEnabled() const { return m_pattern.size() >= MinLength; }
+
+    // Edits allowed for this query length: 0 below 4 characters
+    int maxTypos() const { return m_maxTypos; }
+    static int maxTyposFor(qsizetype length);
+
+    // Higher is better; -1 when the pattern is not a subsequence
+    int subsequence(QStringView text, quint64 textMask) const;
+
+    // Edit distance to the best substring, or maxTypos() + 1 when above it
+    int editDistance(QStringView text, quint64 textMask) const;
+
+    static quint64 charMask(QStringView text);
+
+private:
+    QString m_pattern;
+    quint64 m_mask = 0;
+    int m_maxTypos = 0;
+
+    // Myers match vectors: bit i is set where pattern[i] == c
+    std::array<quint64, 128> m_peqAscii{};
+    std::vector<std::pair<char16_t, quint64>> m_peqOther;
+
+    quint64 peq(char16_t c) const;
+};
@@ -0,0 +1,173 @@
+#include "launchlog.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// -----------------------------
+// On-disk layout (native endian, local state only)
+// -----------------------------
+namespace {
+
+constexpr char Magic[8] = {'W', '8', 'L', 'A', 'U', 'N', 'C', 'H'};
+constexpr quint32 Version = 1;
+constexpr quint32 MaxKeySize = 4096;
+
+struct LogHeader {
+    char magic[8];
+    quint32 version;
+    quint32 reserved;
+};
+
+// Followed by keySize bytes of UTF-8
+struct LogRecord {
+    qint64 time;               // seconds since the epoch
+    double weight;             // 1 per launch; the decayed score after compaction
+    quint32 keySize;
+    quint32 reserved;
+};
+
+static_assert(sizeof(LogHeader) == 16, "launch log header layout changed");
+static_assert(sizeof(LogRecord) == 24, "launch log record layout changed");
+
+QByteArray headerBytes() {
+    LogHeader h{};
+    std::memcpy(h.magic, Magic, sizeof(Magic));
+    h.version = Version;
+    return QByteArray(reinterpret_cast<const char *>(&h), sizeof(h));
+}
+
+void appendRecord(QByteArray *out, qint64 time, double weight, const QString &key) {
+    const QByteArray utf8 = key.toUtf8();
+    LogRecord r{};
+    r.time = time;
+    r.weight = weight;
+    r.keySize = quint32(utf8.size());
+    out->append(reinterpret_cast<const char *>(&r), sizeof(r));
+    out->append(utf8);
+}
+
+// Share of a score that is left after `elapsed` seconds
+double decay(qint64 elapsed) {
+    constexpr double halfLife = LaunchLog::HalfLifeDays * 24 * 3600;
+    return std::exp2(-double(std::max<qint64>(0, elapsed)) / halfLife);
+}
+
+} // namespace
+
+LaunchLog::LaunchLog(const QString &path, QObject *parent)
+: QObject(parent)
+, m_path(path) {
+    m_io.setMaxThreadCount(1);
+    load();
+}
+
+LaunchLog::~LaunchLog() {
+    m_io.waitForDone();
+}
+
+// -----------------------------
+// Frecency
+// -----------------------------
+void LaunchLog::add(Entry *entry, qint64 time, double weight) {
+    entry->score = entry->score * decay(time - entry->time) + weight;
+    entry->time = std::max(entry->time, time);
+}
+
+double LaunchLog::frecency(const QString &key, qint64 now) const {
+    auto it = m_entries.constFind(key);
+    if (it == m_entries.constEnd())
+        return 0;
+    return it->score * decay(now - it->time);
+}
+
+// -----------------------------
+// Record
+// -----------------------------
+// The table is updated in place; the append is queued behind any earlier
+// write
+void LaunchLog::record(const QString &key) {
+    if (key.isEmpty() || key.toUtf8().size() > qsizetype(MaxKeySize))
+        return;
+
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    add(&m_entries[key], now, 1.0);
+    emit launched(key);
+
+    QByteArray bytes;
+    appendRecord(&bytes, now, 1.0, key);
+    m_io.start([path = m_path, bytes]() {
+        QFile f(path);
+        if (!f.open(QIODevice::Append)) {
+            qWarning() << "⚠️ Launch log not writable:" << path;
+            return;
+        }
+        if (f.size() == 0)
+            f.write(headerBytes());
+        f.write(bytes);
+    });
+
+    if (++m_appended > CompactAfter)
+        compact();
+}
+
+// -----------------------------
+// Load / compact
+// -----------------------------
+void LaunchLog::load() {
+    QFile f(m_path);
+    if (!f.open(QIODevice::ReadOnly))
+        return;
+
+    const QByteArray data = f.readAll();
+    const char *p = data.constData();
+    const char *end = p + data.size();
+
+    LogHeader h;
+    if (data.size() < qsizetype(sizeof(h)))
+        return;
+    std::memcpy(&h, p, sizeof(h));
+    if (std::memcmp(h.magic, Magic, sizeof(Magic)) != 0 || h.version != Version) {
+        qWarning() << "⚠️ Ignoring launch log from another version:" << m_path;
+        return;
+    }
+    p += sizeof(h);
+
+    // A record cut short by a crash ends the log
+    int records = 0;
+    while (end - p >= qsizetype(sizeof(LogRecord))) {
+        LogRecord r;
+        std::memcpy(&r, p, sizeof(r));
+        p += sizeof(r);
+        if (r.keySize > MaxKeySize || end - p < qsizetype(r.keySize) || !std::isfinite(r.weight))
+            break;
+        const QString key = QString::fromUtf8(p, qsizetype(r.keySize));
+        p += r.keySize;
+
+        add(&m_entries[key], r.time, r.weight);
+        ++records;
+    }
+
+    m_appended = records - int(m_entries.size());
+    if (m_appended > CompactAfter || p != end)
+        compact();
+}
+
+// One record per key, weighted by its decayed score
+void LaunchLog::compact() {
+    QByteArray bytes = headerBytes();
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it)
+        appendRecord(&bytes, it->time, it->score, it.key());
+    m_appended = 0;
+
+    m_io.start([path = m_path, bytes]() {
+        QSaveFile f(path);
+        if (!f.open(QIODevice::WriteOnly) || f.write(bytes) != bytes.size() || !f.commit())
+            qWarning() << "⚠️ Could not compact the launch log:" << path;
+    });
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+
+// ----------------------------
+// LaunchLog
+// ----------------------------
+// Frecency of launched apps, keyed by desktop file path (or by command for
+// launches without one).
+//
+// Every launch appends one small record to a binary log; the in-memory
+// table keeps one exponentially decaying score per key, so an app launched
+// often and lately ranks above one launched often long ago. Because a
+// decayed score is just another weighted launch, compaction rewrites the
+// log as one record per key without losing anything.
+//
+// File I/O runs on a private single-thread pool, in order; record() never
+// waits for the disk.
+class LaunchLog : public QObject {
+    Q_OBJECT
+public:
+    static constexpr double HalfLifeDays = 7.0;
+    static constexpr int CompactAfter = 512;     // appended records
+
+    explicit LaunchLog(const QString &path, QObject *parent = nullptr);
+    ~LaunchLog() override;
+
+    void record(const QString &key);
+
+    // Decayed launch count at `now` (seconds since the epoch); scores taken
+    // at the same `now` compare like for like
+    double frecency(const QString &key, qint64 now) const;
+
+signals:
+    void launched(const QString &key);
+
+private:
+    struct Entry {
+        double score = 0;
+        qint64 time = 0;      // seconds since the epoch, of the last record
+    };
+
+    QString m_path;
+    QHash<QString, Entry> m_entries;
+    int m_appended = 0;       // records in the file beyond one per key
+    QThreadPool m_io;
+
+    static void add(Entry *entry, qint64 time, double weight);
+    void load();
+    void compact();
+};
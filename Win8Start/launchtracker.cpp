@@ -0,0 +1,236 @@
+#include "launchtracker.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QTimer>
+
+#include <algorithm>
+
+// -----------------------------
+// Histogram
+// -----------------------------
+void LaunchTracker::Histogram::add(double ms) {
+    const auto it = std::lower_bound(BoundsMs.begin(), BoundsMs.end(), ms);
+    ++buckets[size_t(it - BoundsMs.begin())];
+    ++count;
+    sumMs += ms;
+    maxMs = std::max(maxMs, ms);
+}
+
+double LaunchTracker::Histogram::percentile(double p) const {
+    if (count == 0)
+        return 0;
+    const double rank = p * count;
+    quint32 seen = 0;
+    for (size_t i = 0; i < BoundsMs.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank)
+            return std::min<double>(BoundsMs[i], maxMs);
+    }
+    return maxMs;
+}
+
+QJsonObject LaunchTracker::Histogram::toJson() const {
+    QJsonArray b;
+    for (quint32 n : buckets)
+        b.append(qint64(n));
+    return {{"buckets", b}, {"count", qint64(count)}, {"sumMs", sumMs}, {"maxMs", maxMs}};
+}
+
+LaunchTracker::Histogram LaunchTracker::Histogram::fromJson(const QJsonObject &o) {
+    Histogram h;
+    const QJsonArray b = o.value("buckets").toArray();
+    if (b.size() != qsizetype(h.buckets.size()))
+        return h;    // other bucket layout; start over
+    for (size_t i = 0; i < h.buckets.size(); ++i)
+        h.buckets[i] = quint32(b[qsizetype(i)].toInteger());
+    h.count = quint32(o.value("count").toInteger());
+    h.sumMs = o.value("sumMs").toDouble();
+    h.maxMs = o.value("maxMs").toDouble();
+    return h;
+}
+
+// -----------------------------
+// Constructor / Destructor
+// -----------------------------
+LaunchTracker::LaunchTracker(const QString &path, QObject *parent)
+: QObject(parent)
+, m_path(path) {
+    m_clock.start();
+
+    m_saveTimer = new QTimer(this);
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(5000);
+    connect(m_saveTimer, &QTimer::timeout, this, [this]() { save(); });
+
+    load();
+}
+
+LaunchTracker::~LaunchTracker() {
+    if (m_saveTimer->isActive())
+        save();
+}
+
+// -----------------------------
+// Launch events
+// -----------------------------
+quint64 LaunchTracker::begin(const QString &key, const QStringList &appIds) {
+    expire();
+
+    Pending p;
+    p.id = m_nextId++;
+    p.key = key;
+    for (const QString &id : appIds)
+        p.appIds << id.toLower();
+    p.clickNs = m_clock.nsecsElapsed();
+    m_pending.append(p);
+    return p.id;
+}
+
+void LaunchTracker::spawned(quint64 launch, qint64 pid) {
+    for (Pending &p : m_pending) {
+        if (p.id != launch)
+            continue;
+        p.spawnNs = m_clock.nsecsElapsed();
+        p.pid = pid;
+        m_stats[p.key].spawn.add(double(p.spawnNs - p.clickNs) / 1e6);
+        return;
+    }
+}
+
+void LaunchTracker::failed(quint64 launch) {
+    m_pending.removeIf([launch](const Pending &p) { return p.id == launch; });
+}
+
+void LaunchTracker::windowShown(const QString &appId) {
+    expire();
+
+    QString id = appId.toLower();
+    if (id.endsWith(".desktop"))
+        id.chop(8);
+
+    // The oldest launch this window can belong to
+    for (qsizetype i = 0; i < m_pending.size(); ++i) {
+        const Pending &p = m_pending[i];
+        if (!p.appIds.contains(id))
+            continue;
+
+        const double ms = double(m_clock.nsecsElapsed() - p.clickNs) / 1e6;
+        m_stats[p.key].window.add(ms);
+        qDebug() << "⏱️ Launch" << p.key << "pid" << p.pid << "window after" << qRound(ms) << "ms";
+
+        m_pending.removeAt(i);
+        scheduleSave();
+        return;
+    }
+}
+
+void LaunchTracker::expire() {
+    const qint64 now = m_clock.nsecsElapsed();
+    const qsizetype before = m_pending.size();
+    m_pending.removeIf([&](const Pending &p) {
+        if (now - p.clickNs < TimeoutMs * 1000000)
+            return false;
+        ++m_stats[p.key].timeouts;
+        return true;
+    });
+    if (m_pending.size() != before)
+        scheduleSave();
+}
+
+QStringList LaunchTracker::appIdsFor(const QString &desktopFile, const QString &program) {
+    QStringList ids;
+    if (!desktopFile.isEmpty()) {
+        QString id = QFileInfo(desktopFile).fileName();
+        if (id.endsWith(".desktop"))
+            id.chop(8);
+        ids << id << id.section('.', -1);
+    }
+    if (!program.isEmpty())
+        ids << QFileInfo(program).fileName();
+    ids.removeDuplicates();
+    return ids;
+}
+
+// -----------------------------
+// Dump
+// -----------------------------
+QByteArray LaunchTracker::dump() const {
+    QStringList keys = m_stats.keys();
+    std::sort(keys.begin(), keys.end(), [this](const QString &a, const QString &b) {
+        return m_stats[a].window.percentile(0.5) > m_stats[b].window.percentile(0.5);
+    });
+
+    QByteArray out;
+    QTextStream s(&out);
+    s << qSetFieldWidth(44) << Qt::left << "app" << qSetFieldWidth(9) << Qt::right
+      << "launches" << "spawn50" << "win50" << "win90" << "win99" << "winmax" << "timeout"
+      << qSetFieldWidth(0) << "\n";
+
+    for (const QString &key : keys) {
+        const AppStats &st = m_stats[key];
+        QString name = QFileInfo(key).fileName();
+        if (name.isEmpty())
+            name = key;
+        s << qSetFieldWidth(44) << Qt::left << name.left(43) << qSetFieldWidth(9) << Qt::right
+          << st.window.count + st.timeouts
+          << qRound(st.spawn.percentile(0.5))
+          << qRound(st.window.percentile(0.5))
+          << qRound(st.window.percentile(0.9))
+          << qRound(st.window.percentile(0.99))
+          << qRound(st.window.maxMs)
+          << st.timeouts
+          << qSetFieldWidth(0) << "\n";
+    }
+    s << "(milliseconds from the click; percentiles are bucket upper bounds)\n";
+    s.flush();
+    return out;
+}
+
+// -----------------------------
+// Persistence
+// -----------------------------
+void LaunchTracker::load() {
+    QFile f(m_path);
+    if (!f.open(QIODevice::ReadOnly))
+        return;
+
+    const QJsonObject apps = QJsonDocument::fromJson(f.readAll()).object();
+    for (auto it = apps.constBegin(); it != apps.constEnd(); ++it) {
+        const QJsonObject o = it->toObject();
+        AppStats st;
+        st.spawn = Histogram::fromJson(o.value("spawn").toObject());
+        st.window = Histogram::fromJson(o.value("window").toObject());
+        st.timeouts = quint32(o.value("timeouts").toInteger());
+        m_stats.insert(it.key(), st);
+    }
+}
+
+void LaunchTracker::save() const {
+    QJsonObject apps;
+    for (auto it = m_stats.cbegin(); it != m_stats.cend(); ++it) {
+        apps.insert(it.key(), QJsonObject{
+            {"spawn", it->spawn.toJson()},
+            {"window", it->window.toJson()},
+            {"timeouts", qint64(it->timeouts)}
+        });
+    }
+
+    QSaveFile f(m_path);
+    if (!f.open(QIODevice::WriteOnly)) {
+        qWarning() << "⚠️ Could not save launch latencies:" << m_path;
+        return;
+    }
+    f.write(QJsonDocument(apps).toJson(QJsonDocument::Compact));
+    f.commit();
+}
+
+void LaunchTracker::scheduleSave() {
+    if (!m_saveTimer->isActive())
+        m_saveTimer->start();
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include <array>
+
+class QTimer;
+
+// ----------------------------
+// LaunchTracker
+// ----------------------------
+// Launch-to-window latency per app. Every launch is timestamped at the
+// click, when the spawn helper reports the pid, and when the first
+// toplevel whose app_id matches the launched entry is ready. The two
+// latencies go into per-app histograms that are kept across restarts and
+// printed by `Win8Start --launch-stats`.
+//
+// Matching is by app_id only (foreign-toplevel has no pid): the desktop
+// ID, its last reverse-DNS component or the executable name, compared
+// case-insensitively. Launches without a window within TimeoutMs are counted
+// as timeouts.
+class LaunchTracker : public QObject {
+    Q_OBJECT
+public:
+    static constexpr qint64 TimeoutMs = 60000;
+
+    explicit LaunchTracker(const QString &path, QObject *parent = nullptr);
+    ~LaunchTracker() override;
+
+    // At the click; `appIds` are the app_ids the window may carry.
+    // Returns the id for spawned() / failed().
+    quint64 begin(const QString &key, const QStringList &appIds);
+    void spawned(quint64 launch, qint64 pid);
+    void failed(quint64 launch);
+
+    // A toplevel got its first app_id
+    void windowShown(const QString &appId);
+
+    // The app_ids a window of `desktopFile` / `program` is likely to use
+    static QStringList appIdsFor(const QString &desktopFile, const QString &program);
+
+    // Human-readable table, slowest apps first
+    QByteArray dump() const;
+
+private:
+    // Log-spaced buckets; the last one is open-ended
+    struct Histogram {
+        static constexpr std::array<int, 13> BoundsMs = {
+            25, 50, 100, 200, 350, 500, 750, 1000, 1500, 2000, 3000, 5000, 10000
+        };
+
+        std::array<quint32, BoundsMs.size() + 1> buckets{};
+        quint32 count = 0;
+        double sumMs = 0;
+        double maxMs = 0;
+
+        void add(double ms);
+        double percentile(double p) const;   // upper bound of the bucket
+        QJsonObject toJson() const;
+        static Histogram fromJson(const QJsonObject &o);
+    };
+
+    struct AppStats {
+        Histogram spawn;      // click -> pid
+        Histogram window;     // click -> first matching toplevel
+        quint32 timeouts = 0;
+    };
+
+    struct Pending {
+        quint64 id;
+        QString key;
+        QStringList appIds;   // lower case
+        qint64 clickNs;
+        qint64 spawnNs = -1;
+        qint64 pid = -1;
+    };
+
+    QString m_path;
+    QElapsedTimer m_clock;
+    quint64 m_nextId = 1;
+    QList<Pending> m_pending;             // oldest first
+    QHash<QString, AppStats> m_stats;
+    QTimer *m_saveTimer = nullptr;
+
+    void expire();
+    void load();
+    void save() const;
+    void scheduleSave();
+};
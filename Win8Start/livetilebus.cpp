@@ -0,0 +1,353 @@
+#include "livetilebus.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QMutexLocker>
+#include <QQmlEngine>
+#include <QStandardPaths>
+#include <QUrl>
+#include <QtEndian>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// Directory of a tile.qml (path or file URL), or the directory itself
+QString tileDirOf(const QString &path) {
+    const QFileInfo info(path.startsWith("file:") ? QUrl(path).toLocalFile() : path);
+    return info.isDir() ? info.absoluteFilePath() : info.absolutePath();
+}
+
+QString idOf(const QString &tileDir) {
+    return QString::fromLatin1(
+        QCryptographicHash::hash(tileDir.toUtf8(), QCryptographicHash::Sha1).toHex().left(16));
+}
+
+// Copy of the first `size` bytes of a POSIX shared memory object
+QByteArray readShm(const QString &name, qint64 size) {
+    QByteArray shmName = QFile::encodeName(name);
+    if (!shmName.startsWith('/'))
+        shmName.prepend('/');
+
+    const int fd = shm_open(shmName.constData(), O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0)
+        return {};
+
+    QByteArray bytes;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size >= size) {
+        void *base = mmap(nullptr, size_t(size), PROT_READ, MAP_SHARED, fd, 0);
+        if (base != MAP_FAILED) {
+            bytes = QByteArray(static_cast<const char *>(base), qsizetype(size));
+            munmap(base, size_t(size));
+        }
+    }
+    close(fd);
+    return bytes;
+}
+
+} // namespace
+
+// -----------------------------
+// LiveTileChannel
+// -----------------------------
+void LiveTileChannel::publish(const QVariantMap &values) {
+    bool changed = false;
+    for (auto it = values.cbegin(); it != values.cend(); ++it) {
+        if (it->isNull()) {
+            changed |= m_data.remove(it.key()) > 0;
+            continue;
+        }
+        const auto current = m_data.constFind(it.key());
+        if (current != m_data.cend() && *current == *it)
+            continue;
+        m_data.insert(it.key(), *it);
+        changed = true;
+    }
+    if (changed)
+        emit dataChanged();
+}
+
+void LiveTileChannel::clear() {
+    if (m_data.isEmpty())
+        return;
+    m_data.clear();
+    emit dataChanged();
+}
+
+// -----------------------------
+// LiveTileImageProvider
+// -----------------------------
+QImage LiveTileImageProvider::requestImage(const QString &id, QSize *size, const QSize &requestedSize) {
+    QImage image;
+    {
+        QMutexLocker lock(&m_images->mutex);
+        image = m_images->images.value(id.left(id.lastIndexOf('/')));
+    }
+
+    if (!image.isNull() && requestedSize.width() > 0 && requestedSize.height() > 0)
+        image = image.scaled(requestedSize, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+    else if (!image.isNull() && requestedSize.width() > 0)
+        image = image.scaledToWidth(requestedSize.width(), Qt::SmoothTransformation);
+    else if (!image.isNull() && requestedSize.height() > 0)
+        image = image.scaledToHeight(requestedSize.height(), Qt::SmoothTransformation);
+
+    if (size)
+        *size = image.size();
+    return image;
+}
+
+// -----------------------------
+// Constructor / Destructor
+// -----------------------------
+LiveTileBus::LiveTileBus(QObject *parent)
+: QObject(parent)
+, m_images(std::make_shared<LiveTileImages>()) {
+    m_runtimeDir = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation) + "/win8start-tiles";
+    QDir().mkpath(m_runtimeDir);
+    QFile::setPermissions(m_runtimeDir, QFile::ReadOwner | QFile::WriteOwner | QFile::ExeOwner);
+}
+
+LiveTileBus::~LiveTileBus() {
+    for (Tile &t : m_tiles) {
+        if (!t.server)
+            continue;
+        for (QLocalSocket *socket : t.server->findChildren<QLocalSocket *>())
+            socket->disconnect(this);
+        t.server->close();
+    }
+}
+
+// -----------------------------
+// Tiles
+// -----------------------------
+LiveTileBus::Tile &LiveTileBus::tile(const QString &tileDir) {
+    auto it = m_tiles.find(tileDir);
+    if (it != m_tiles.end())
+        return *it;
+
+    Tile &t = m_tiles[tileDir];
+    t.id = idOf(tileDir);
+    t.channel = new LiveTileChannel(this);
+    QQmlEngine::setObjectOwnership(t.channel, QQmlEngine::CppOwnership);
+    return t;
+}
+
+void LiveTileBus::sync(const QSet<QString> &tileDirs) {
+    for (auto it = m_tiles.begin(); it != m_tiles.end(); ++it) {
+        if (!it->server || tileDirs.contains(it.key()))
+            continue;
+
+        for (QLocalSocket *socket : it->server->findChildren<QLocalSocket *>())
+            socket->disconnect(this);
+        delete it->server;
+        it->server = nullptr;
+
+        // Nothing will update it any more
+        const bool wasConnected = it->channel->connected();
+        it->channel->m_connections = 0;
+        it->channel->clear();
+        if (wasConnected)
+            emit it->channel->connectedChanged();
+
+        QMutexLocker lock(&m_images->mutex);
+        for (const QString &name : it->imageHashes.keys())
+            m_images->images.remove(it->id + '/' + name);
+        it->imageHashes.clear();
+    }
+
+    for (const QString &dir : tileDirs)
+        listen(dir);
+}
+
+QString LiveTileBus::socketPath(const QString &tileDir) const {
+    return m_runtimeDir + '/' + idOf(tileDir) + ".sock";
+}
+
+LiveTileChannel *LiveTileBus::channel(const QString &tilePath) {
+    return tile(tileDirOf(tilePath)).channel;
+}
+
+QQuickImageProvider *LiveTileBus::createImageProvider() const {
+    return new LiveTileImageProvider(m_images);
+}
+
+// -----------------------------
+// Sockets
+// -----------------------------
+void LiveTileBus::listen(const QString &tileDir) {
+    Tile &t = tile(tileDir);
+    if (t.server)
+        return;
+
+    const QString path = socketPath(tileDir);
+    QLocalServer::removeServer(path);     // stale, from a crash
+
+    auto *server = new QLocalServer(this);
+    server->setSocketOptions(QLocalServer::UserAccessOption);
+    if (!server->listen(path)) {
+        qWarning() << "⚠️ Live tile socket failed:" << path << server->errorString();
+        delete server;
+        return;
+    }
+
+    connect(server, &QLocalServer::newConnection, this, [this, tileDir]() { accept(tileDir); });
+    t.server = server;
+}
+
+void LiveTileBus::accept(const QString &tileDir) {
+    Tile &t = tile(tileDir);
+    while (t.server && t.server->hasPendingConnections()) {
+        QLocalSocket *socket = t.server->nextPendingConnection();
+        auto buffer = std::make_shared<QByteArray>();
+
+        if (t.channel->m_connections++ == 0)
+            emit t.channel->connectedChanged();
+
+        connect(socket, &QLocalSocket::readyRead, this, [this, tileDir, socket, buffer]() {
+            if (!read(tileDir, socket, buffer.get())) {
+                qWarning() << "⚠️ Dropping live tile connection, bad message:" << tileDir;
+                socket->abort();
+            }
+        });
+        connect(socket, &QLocalSocket::disconnected, this, [this, tileDir, socket]() {
+            socket->disconnect(this);
+            socket->deleteLater();
+            LiveTileChannel *channel = tile(tileDir).channel;
+            if (channel->m_connections > 0 && --channel->m_connections == 0)
+                emit channel->connectedChanged();
+        });
+    }
+}
+
+// Every complete message in the socket's buffer; false on a bad one
+bool LiveTileBus::read(const QString &tileDir, QLocalSocket *socket, QByteArray *buffer) {
+    buffer->append(socket->readAll());
+
+    while (buffer->size() >= HeaderBytes) {
+        const quint8 kind = quint8(buffer->at(0));
+        const quint32 length = qFromLittleEndian<quint32>(buffer->constData() + 1);
+        if (length > MaxPayloadBytes)
+            return false;
+        if (buffer->size() < HeaderBytes + qsizetype(length))
+            break;
+
+        const QByteArray payload = buffer->mid(HeaderBytes, length);
+        buffer->remove(0, HeaderBytes + qsizetype(length));
+        if (!handle(tileDir, kind, payload))
+            return false;
+    }
+    return true;
+}
+
+// -----------------------------
+// Messages
+// -----------------------------
+bool LiveTileBus::handle(const QString &tileDir, quint8 kind, const QByteArray &payload) {
+    switch (kind) {
+    case Json: {
+        QJsonParseError error;
+        const QJsonDocument doc = QJsonDocument::fromJson(payload, &error);
+        if (error.error != QJsonParseError::NoError || !doc.isObject())
+            return false;
+        publish(tileDir, doc.object().toVariantMap());
+        return true;
+    }
+    case Blob: {
+        if (payload.size() < 2)
+            return false;
+        const quint16 nameLength = qFromLittleEndian<quint16>(payload.constData());
+        if (nameLength == 0 || payload.size() < 2 + nameLength)
+            return false;
+        const QString name = QString::fromUtf8(payload.constData() + 2, nameLength);
+        publish(tileDir, {{name, payload.mid(2 + nameLength)}});
+        return true;
+    }
+    case Image:
+        return handleImage(tileDir, payload);
+    default:
+        return false;
+    }
+}
+
+bool LiveTileBus::handleImage(const QString &tileDir, const QByteArray &payload) {
+    const QJsonObject o = QJsonDocument::fromJson(payload).object();
+    const QString name = o.value("name").toString();
+    const QString shm = o.value("shm").toString();
+    const qint64 size = o.value("size").toInteger();
+    const QString format = o.value("format").toString("encoded");
+    if (name.isEmpty() || shm.isEmpty() || size <= 0 || size > MaxPayloadBytes)
+        return false;
+
+    // Gone already, or still being written: skip this one, keep the link
+    const QByteArray bytes = readShm(shm, size);
+    if (bytes.isEmpty()) {
+        qWarning() << "⚠️ Live tile image not readable:" << shm;
+        return true;
+    }
+
+    const size_t hash = qHash(bytes);
+    const Tile &t = tile(tileDir);
+    if (t.imageHashes.contains(name) && t.imageHashes.value(name) == hash)
+        return true;
+
+    QImage image;
+    if (format == "encoded") {
+        image = QImage::fromData(bytes);
+    } else if (format == "argb32") {
+        const int width = o.value("width").toInt();
+        const int height = o.value("height").toInt();
+        const qint64 stride = o.value("stride").toInteger(qint64(width) * 4);
+        if (width <= 0 || height <= 0 || stride < qint64(width) * 4 || stride * height > size)
+            return false;
+        image = QImage(reinterpret_cast<const uchar *>(bytes.constData()), width, height,
+                       qsizetype(stride), QImage::Format_ARGB32).copy();
+    } else {
+        return false;
+    }
+
+    if (image.isNull()) {
+        qWarning() << "⚠️ Live tile image not decodable:" << tileDir << name;
+        return true;
+    }
+    setImage(tileDir, name, image, hash);
+    return true;
+}
+
+// -----------------------------
+// Publishing
+// -----------------------------
+void LiveTileBus::publish(const QString &tileDir, const QVariantMap &values) {
+    tile(tileDir).channel->publish(values);
+}
+
+void LiveTileBus::publishImage(const QString &tileDir, const QString &name, const QImage &image) {
+    const size_t hash = qHashBits(image.constBits(), size_t(image.sizeInBytes()));
+    const Tile &t = tile(tileDir);
+    if (t.imageHashes.contains(name) && t.imageHashes.value(name) == hash)
+        return;
+    setImage(tileDir, name, image, hash);
+}
+
+// A new URL per picture, so QML reloads once and only then
+void LiveTileBus::setImage(const QString &tileDir, const QString &name, const QImage &image, size_t hash) {
+    Tile &t = tile(tileDir);
+    const QString key = t.id + '/' + name;
+    {
+        QMutexLocker lock(&m_images->mutex);
+        m_images->images.insert(key, image);
+    }
+    t.imageHashes.insert(name, hash);
+    const quint32 serial = ++t.imageSerials[name];
+    t.channel->publish({{name, QString("image://livetile/%1/%2").arg(key).arg(serial)}});
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QObject>
+#include <QQuickImageProvider>
+#include <QSet>
+#include <QString>
+#include <QVariantMap>
+
+#include <memory>
+
+class QLocalServer;
+class QLocalSocket;
+
+// ----------------------------
+// LiveTileChannel
+// ----------------------------
+// What a tile's logic has published, as seen from the tile's QML (the
+// `liveTile` property the tile Loader sets). `data` holds the latest value
+// of every key; images are there as image://livetile URLs that change
+// only when the picture does.
+class LiveTileChannel : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(QVariantMap data READ data NOTIFY dataChanged)
+    Q_PROPERTY(bool connected READ connected NOTIFY connectedChanged)
+public:
+    explicit LiveTileChannel(QObject *parent = nullptr) : QObject(parent) {}
+
+    QVariantMap data() const { return m_data; }
+    bool connected() const { return m_connections > 0; }
+
+    // A null value removes the key; emits only when something differs
+    void publish(const QVariantMap &values);
+    void clear();
+
+signals:
+    void dataChanged();
+    void connectedChanged();
+
+private:
+    friend class LiveTileBus;
+
+    QVariantMap m_data;
+    int m_connections = 0;
+};
+
+// ----------------------------
+// LiveTileImages
+// ----------------------------
+// Decoded live tile images by "<tile>/<name>", shared between the bus (GUI
+// thread) and the image provider (QML loader threads)
+struct LiveTileImages {
+    QMutex mutex;
+    QHash<QString, QImage> images;
+};
+
+class LiveTileImageProvider : public QQuickImageProvider {
+public:
+    explicit LiveTileImageProvider(std::shared_ptr<LiveTileImages> images)
+    : QQuickImageProvider(QQuickImageProvider::Image), m_images(std::move(images)) {}
+
+    // id: <tile>/<name>/<serial>
+    QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override;
+
+private:
+    std::shared_ptr<LiveTileImages> m_images;
+};
+
+// ----------------------------
+// LiveTileBus
+// ----------------------------
+// Push channel from live tile logic (logic.py or a native provider) to the
+// tile's QML. Each live tile directory gets a Unix socket, passed to its
+// logic.py as $WIN8START_TILE_SOCKET; messages update the tile's
+// LiveTileChannel, so the tile redraws when the data changes instead of
+// polling files.
+//
+// Every message is a 5-byte header, kind (u8) and payload length (u32,
+// little endian), then the payload:
+//
+//   Json   a UTF-8 JSON object, merged into `data`
+//   Blob   u16 name length, the name (UTF-8), then the bytes: data[name]
+//          is the QByteArray (an ArrayBuffer in QML)
+//   Image  a JSON object describing a POSIX shared memory object:
+//          {"name", "shm", "size", "format"}, "format" being "encoded" (PNG,
+//          JPEG, ... as on disk) or "argb32" with "width", "height" and
+//          "stride". The pixels are copied out at once, so the writer can
+//          reuse or unlink the object after its next message.
+//
+// A payload over MaxPayloadBytes, or a malformed one, drops the connection.
+class LiveTileBus : public QObject {
+    Q_OBJECT
+public:
+    static constexpr quint32 MaxPayloadBytes = 16 * 1024 * 1024;
+    static constexpr int HeaderBytes = 5;
+
+    enum Kind : quint8 {
+        Json  = 1,
+        Blob  = 2,
+        Image = 3
+    };
+
+    explicit LiveTileBus(QObject *parent = nullptr);
+    ~LiveTileBus() override;
+
+    // Listen for exactly the tile directories in `tileDirs`
+    void sync(const QSet<QString> &tileDirs);
+
+    QString socketPath(const QString &tileDir) const;
+
+    // The channel of a tile, by tile.qml path or directory; stays valid for
+    // the lifetime of the bus
+    Q_INVOKABLE LiveTileChannel *channel(const QString &tilePath);
+
+    // Owned by the engine; images outlive the bus
+    QQuickImageProvider *createImageProvider() const;
+
+    // Publish from C++ (native tile providers)
+    void publish(const QString &tileDir, const QVariantMap &values);
+    void publishImage(const QString &tileDir, const QString &name, const QImage &image);
+
+private:
+    struct Tile {
+        QString id;                       // hash of the directory; socket and image ids
+        QLocalServer *server = nullptr;
+        LiveTileChannel *channel = nullptr;
+        QHash<QString, size_t> imageHashes;
+        QHash<QString, quint32> imageSerials;
+    };
+
+    QString m_runtimeDir;
+    QHash<QString, Tile> m_tiles;         // by directory
+    std::shared_ptr<LiveTileImages> m_images;
+
+    Tile &tile(const QString &tileDir);
+    void listen(const QString &tileDir);
+    void accept(const QString &tileDir);
+    bool read(const QString &tileDir, QLocalSocket *socket, QByteArray *buffer);
+    bool handle(const QString &tileDir, quint8 kind, const QByteArray &payload);
+    bool handleImage(const QString &tileDir, const QByteArray &payload);
+    void setImage(const QString &tileDir, const QString &name, const QImage &image, size_t hash);
+};
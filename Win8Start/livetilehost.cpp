@@ -0,0 +1,229 @@
+#include "livetilehost.h"
+#include "livetilebus.h"
+#include "livetileplugin.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QImage>
+#include <QList>
+#include <QMetaProperty>
+#include <QPluginLoader>
+#include <QThread>
+#include <QVariantMap>
+
+#include <utility>
+
+namespace {
+
+// Calls an optional slot of the provider, on the provider's thread
+void callIfDeclared(QObject *provider, const char *signature) {
+    const int method = provider->metaObject()->indexOfMethod(signature);
+    if (method >= 0)
+        provider->metaObject()->method(method).invoke(provider, Qt::DirectConnection);
+}
+
+void pauseProvider(QObject *provider, bool paused) {
+    const int method = provider->metaObject()->indexOfMethod("setPaused(bool)");
+    if (method >= 0)
+        provider->metaObject()->method(method).invoke(provider, Qt::DirectConnection, Q_ARG(bool, paused));
+}
+
+} // namespace
+
+// -----------------------------
+// ProviderRelay
+// -----------------------------
+// Lives on the provider's thread and reads its properties there, when
+// their NOTIFY signals fire; the values cross to the GUI thread by signal
+class ProviderRelay : public QObject {
+    Q_OBJECT
+public:
+    explicit ProviderRelay(QObject *provider)
+    : m_provider(provider) {
+        const QMetaObject *meta = provider->metaObject();
+        const int slot = metaObject()->indexOfSlot("notified()");
+        for (int i = QObject::staticMetaObject.propertyCount(); i < meta->propertyCount(); ++i) {
+            const QMetaProperty property = meta->property(i);
+            if (!property.isReadable())
+                continue;
+            m_properties << i;
+            if (property.hasNotifySignal())
+                QMetaObject::connect(provider, property.notifySignalIndex(), this, slot);
+        }
+    }
+
+    void publishAll() { publish(m_properties); }
+
+signals:
+    void changed(const QVariantMap &values);
+    void imageChanged(const QString &name, const QImage &image);
+
+public slots:
+    void notified() {
+        const int signal = senderSignalIndex();
+        QList<int> properties;
+        for (int i : m_properties) {
+            if (m_provider->metaObject()->property(i).notifySignalIndex() == signal)
+                properties << i;
+        }
+        publish(properties);
+    }
+
+private:
+    QObject *m_provider;
+    QList<int> m_properties;
+
+    void publish(const QList<int> &properties) {
+        QVariantMap values;
+        for (int i : properties) {
+            const QMetaProperty property = m_provider->metaObject()->property(i);
+            const QVariant value = property.read(m_provider);
+            if (value.metaType() == QMetaType::fromType<QImage>())
+                emit imageChanged(QString::fromLatin1(property.name()), value.value<QImage>());
+            else
+                values.insert(QString::fromLatin1(property.name()), value);
+        }
+        if (!values.isEmpty())
+            emit changed(values);
+    }
+};
+
+// -----------------------------
+// Constructor / Destructor
+// -----------------------------
+LiveTilePluginHost::LiveTilePluginHost(LiveTileBus *bus, QObject *parent)
+: QObject(parent)
+, m_bus(bus) {}
+
+LiveTilePluginHost::~LiveTilePluginHost() {
+    for (const Plugin &p : std::as_const(m_plugins)) {
+        p.thread->disconnect(this);
+        stop(p);
+        if (p.thread->wait(StopTimeoutMs)) {
+            p.loader->unload();
+        } else {
+            // Still running its code; the library has to stay mapped
+            qWarning() << "⚠️ Live tile plugin did not stop:" << p.loader->fileName();
+        }
+    }
+}
+
+// -----------------------------
+// Plugins
+// -----------------------------
+QString LiveTilePluginHost::libraryIn(const QString &tileDir) {
+    const QStringList libraries = QDir(tileDir).entryList({"*.so"}, QDir::Files, QDir::Name);
+    return libraries.isEmpty() ? QString() : QDir(tileDir).filePath(libraries.first());
+}
+
+void LiveTilePluginHost::sync(const QSet<QString> &tileDirs) {
+    for (auto it = m_plugins.begin(); it != m_plugins.end();) {
+        if (tileDirs.contains(it.key())) {
+            ++it;
+            continue;
+        }
+        qDebug() << "🛑 Unloading live tile plugin:" << it->loader->fileName();
+
+        // Unloaded once its thread is done with the library's code
+        const Plugin p = *it;
+        connect(p.thread, &QThread::finished, this, [p]() {
+            p.thread->wait();
+            p.thread->deleteLater();
+            p.loader->unload();
+            p.loader->deleteLater();
+        });
+        stop(p);
+        it = m_plugins.erase(it);
+    }
+
+    // Disabled tiles may try again
+    m_failed.intersect(tileDirs);
+    m_noLibrary.intersect(tileDirs);
+
+    for (const QString &dir : tileDirs) {
+        if (!m_plugins.contains(dir) && !m_failed.contains(dir) && !m_noLibrary.contains(dir))
+            load(dir);
+    }
+}
+
+void LiveTilePluginHost::reload(const QString &tileDir) {
+    m_failed.remove(tileDir);
+    m_noLibrary.remove(tileDir);
+}
+
+void LiveTilePluginHost::load(const QString &tileDir) {
+    const QString library = libraryIn(tileDir);
+    if (library.isEmpty()) {
+        m_noLibrary.insert(tileDir);
+        return;
+    }
+
+    auto *loader = new QPluginLoader(library, this);
+    auto *plugin = qobject_cast<LiveTilePlugin *>(loader->instance());
+    QObject *provider = plugin ? plugin->createProvider(tileDir) : nullptr;
+    if (!provider) {
+        qWarning() << "⚠️ Live tile plugin not loaded:" << library << loader->errorString();
+        loader->unload();
+        delete loader;
+        m_failed.insert(tileDir);
+        return;
+    }
+
+    provider->setParent(nullptr);
+    auto *relay = new ProviderRelay(provider);
+
+    auto *thread = new QThread(this);
+    thread->setObjectName("LiveTile " + QFileInfo(tileDir).fileName());
+    provider->moveToThread(thread);
+    relay->moveToThread(thread);
+
+    // A late value of an unloaded plugin is dropped
+    connect(relay, &ProviderRelay::changed, this, [this, tileDir](const QVariantMap &values) {
+        if (m_plugins.contains(tileDir))
+            m_bus->publish(tileDir, values);
+    });
+    connect(relay, &ProviderRelay::imageChanged, this,
+            [this, tileDir](const QString &name, const QImage &image) {
+                if (m_plugins.contains(tileDir))
+                    m_bus->publishImage(tileDir, name, image);
+            });
+
+    m_plugins.insert(tileDir, {loader, thread, provider, relay});
+    thread->start(QThread::LowPriority);
+
+    const bool paused = m_paused;
+    QMetaObject::invokeMethod(relay, [provider, relay, paused]() {
+        callIfDeclared(provider, "start()");
+        if (paused)
+            pauseProvider(provider, true);
+        relay->publishAll();
+    }, Qt::QueuedConnection);
+
+    qDebug() << "🧩 Live tile plugin loaded:" << library;
+}
+
+void LiveTilePluginHost::setPaused(bool paused) {
+    if (m_paused == paused)
+        return;
+    m_paused = paused;
+
+    for (const Plugin &p : std::as_const(m_plugins)) {
+        QMetaObject::invokeMethod(p.provider, [provider = p.provider, paused]() {
+            pauseProvider(provider, paused);
+        }, Qt::QueuedConnection);
+    }
+}
+
+// On the provider's thread: stop(), then both objects go (deferred
+// deletes run as the thread finishes) and the thread ends
+void LiveTilePluginHost::stop(const Plugin &plugin) {
+    QMetaObject::invokeMethod(plugin.provider, [provider = plugin.provider, relay = plugin.relay]() {
+        callIfDeclared(provider, "stop()");
+        relay->deleteLater();
+        provider->deleteLater();
+        QThread::currentThread()->quit();
+    }, Qt::QueuedConnection);
+}
+
+#include "livetilehost.moc"
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+
+class LiveTileBus;
+class QPluginLoader;
+class QThread;
+
+// ----------------------------
+// LiveTilePluginHost
+// ----------------------------
+// Loads the native LiveTilePlugin of live tile directories and runs each
+// provider on a low priority thread of its own, relaying its properties to
+// the LiveTileBus. A tile's plugin is unloaded when the tile is disabled or
+// unpinned. A directory without a library, or whose library does not
+// load, is not looked at again until then or until it is reloaded; its
+// logic.py (if any) runs instead.
+class LiveTilePluginHost : public QObject {
+    Q_OBJECT
+public:
+    static constexpr unsigned long StopTimeoutMs = 2000;    // at exit
+
+    explicit LiveTilePluginHost(LiveTileBus *bus, QObject *parent = nullptr);
+    ~LiveTilePluginHost() override;
+
+    // Load the plugins of `tileDirs`, unload the others
+    void sync(const QSet<QString> &tileDirs);
+
+    bool isRunning(const QString &tileDir) const { return m_plugins.contains(tileDir); }
+
+    // Look for a library in `tileDir` again on the next sync()
+    void reload(const QString &tileDir);
+
+    void setPaused(bool paused);
+
+    // The plugin library of a tile directory, or empty
+    static QString libraryIn(const QString &tileDir);
+
+private:
+    struct Plugin {
+        QPluginLoader *loader = nullptr;
+        QThread *thread = nullptr;
+        QObject *provider = nullptr;      // on `thread`
+        QObject *relay = nullptr;         // on `thread`
+    };
+
+    LiveTileBus *m_bus;
+    QHash<QString, Plugin> m_plugins;    // by tile directory
+    QSet<QString> m_failed;
+    QSet<QString> m_noLibrary;
+    bool m_paused = false;
+
+    void load(const QString &tileDir);
+    void stop(const Plugin &plugin);
+};
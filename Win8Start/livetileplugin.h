@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QtPlugin>
+
+// ----------------------------
+// LiveTilePlugin
+// ----------------------------
+// Native logic for a live tile, in place of logic.py: a Qt plugin (any
+// *.so next to tile.qml; the first by name is used) whose root object
+// implements this interface.
+//
+//   class ClockPlugin : public QObject, public LiveTilePlugin {
+//       Q_OBJECT
+//       Q_PLUGIN_METADATA(IID LiveTilePlugin_iid)
+//       Q_INTERFACES(LiveTilePlugin)
+//   public:
+//       QObject *createProvider(const QString &tileDir) override;
+//   };
+//
+// The provider is a plain QObject with typed properties. Each readable
+// property shows up in the tile's `liveTile.data` under its name and is
+// sent again whenever its NOTIFY signal fires; QImage properties become
+// image URLs. The provider is moved to a worker thread of its own, where
+// these slots are called if it declares them:
+//
+//   start()             once, before the first values are read
+//   setPaused(bool)     Start menu hidden / shown
+//   stop()              before it is deleted and the library unloaded
+//
+// Nothing here needs symbols from Win8Start, so a plugin only links Qt.
+class LiveTilePlugin {
+public:
+    virtual ~LiveTilePlugin() = default;
+
+    // On the GUI thread; Win8Start owns the result
+    virtual QObject *createProvider(const QString &tileDir) = 0;
+};
+
+#define LiveTilePlugin_iid "org.er-bharat.Win8Start.LiveTilePlugin/1.0"
+Q_DECLARE_INTERFACE(LiveTilePlugin, LiveTilePlugin_iid)
@@ -1,9 +1,10 @@
 // main.cpp
 #include <LayerShellQt/window.h>
 #include <QAbstractListModel>
-#include <QCryptographicHash>
+#include <QDateTime>
 #include <QDir>
 #include <QDrag>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
 #include <QFileSystemWatcher>
@@ -14,6 +15,7 @@
 #include <QJsonObject>
 #include <QList>
 #include <QLockFile>
+#include <QMutex>
 #include <QMimeData>
 #include <QObject>
 #include <QPixmap>
@@ -22,6 +24,8 @@
 #include <QQmlContext>
 #include <QQuickItem>
 #include <QQuickWindow>
+#include <QRectF>
+#include <QSet>
 #include <QStandardPaths>
 #include <QString>
 
@@ -31,6 +35,12 @@
 #include <QDebug>
 #include <QTimer>
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <utility>
+#include <vector>
 #include <pwd.h>
 #include <unistd.h>
 
@@ -43,6 +53,20 @@
 #include <QDBusMessage>
 #include <QVariantMap>
 
+#include "appcache.h"
+#include "appindex.h"
+#include "desktopentry.h"
+#include "launchlog.h"
+#include "launchtracker.h"
+#include "livetilebus.h"
+#include "livetilehost.h"
+#include "pathindex.h"
+#include "prefetcher.h"
+#include "searchindex.h"
+#include "spawnclient.h"
+#include "tilegrid.h"
+#include "tilestore.h"
+#include "tilesupervisor.h"
 #include "windowwatcher.h"
 #include "wlr-foreign-toplevel-management-unstable-v1-client-protocol.h"
 extern "C" {
@@ -64,12 +88,12 @@ public:
     QFuture<R> future = QtConcurrent::run(func);
     QFutureWatcher<R> *watcher = new QFutureWatcher<R>(this);
 
-    // Capture the future by value and callback by value (copy)
+    // Capture the future by value and callback by value (copy); the result
+    // is moved out of the future and into the callback, never copied
     connect(watcher, &QFutureWatcher<R>::finished, this,
             [watcher, future, callback]() mutable {
               try {
-                R result = future.result();
-                callback(result);
+                callback(future.takeResult());
               } catch (...) {
                 // swallow exceptions to avoid crashing; callback may not be
                 // called
@@ -82,19 +106,16 @@ public:
 };
 
 // ----------------------------
-// AppInfo struct
+// Executable lookup
 // ----------------------------
-struct AppInfo {
-  QString name;
-  QString genericName;
-  QStringList keywords;
-  QString command;
-  QString icon;
-  QString desktopFilePath;
-  QStringList categories;
-  bool terminal = false;
-};
-
+// From the PATH index; a miss falls back to the disk, in case the index
+// is still catching up with an install
+static QString resolveExecutable(const QString &program) {
+  QString path = PathIndex::instance().find(program);
+  if (path.isEmpty() && !program.contains('/'))
+    path = QStandardPaths::findExecutable(program);
+  return path;
+}
 
 // ----------------------------
 // AppModel class
@@ -115,33 +136,76 @@ public:
     TerminalRole
   };
   
-  AppModel(QObject *parent = nullptr) : QAbstractListModel(parent) {}
+  AppModel(QObject *parent = nullptr) : QAbstractListModel(parent) {
+    rebuildIndex();
+  }
   
-  void setApps(const QList<AppInfo> &apps) {
-    beginResetModel();
-    m_allApps = apps; // full list
-    m_apps = apps;    // visible list
-    endResetModel();
+  // Background refreshes are applied as a diff keyed on the desktop
+  // file path, so delegates (and their loaded icons) survive
+  void setApps(QList<AppInfo> apps) {
+    QHash<QString, int> newIndex;
+    newIndex.reserve(apps.size());
+    for (int i = 0; i < apps.count(); ++i)
+      newIndex.insert(apps[i].desktopFilePath, i);
+
+    std::vector<int> oldToNew(size_t(m_allApps.size()), -1);
+    std::vector<int> newToOld(size_t(apps.size()), -1);
+    for (int i = 0; i < m_allApps.count(); ++i) {
+      const int n = newIndex.value(m_allApps[i].desktopFilePath, -1);
+      oldToNew[size_t(i)] = n;
+      if (n >= 0)
+        newToOld[size_t(n)] = i;
+    }
+
+    // Applied synchronously; searches still in flight refer to the old list
+    rebuildIndex(apps);
+    const std::vector<int> target = filteredRows();
+    std::vector<char> inTarget(size_t(apps.size()), 0);
+    for (int i : target)
+      inTarget[size_t(i)] = 1;
+
+    // 1. Rows that go away, while their old AppInfo is still in place
+    removeRowsWhere([&](int old) {
+      const int n = oldToNew[size_t(old)];
+      return n < 0 || !inTarget[size_t(n)];
+    });
+
+    // 2. Same apps, new storage
+    const QList<AppInfo> old = std::exchange(m_allApps, std::move(apps));
+    for (int &i : m_rows)
+      i = oldToNew[size_t(i)];
+
+    // 3. Moves and inserts
+    moveAndInsertRows(target);
+
+    // 4. Content of rows that stayed
+    for (int row = 0; row < rowCount(); ++row) {
+      const int o = newToOld[size_t(m_rows[size_t(row)])];
+      if (o >= 0 && !sameContent(old[o], appAt(row)))
+        emit dataChanged(index(row), index(row));
+    }
+    headersChanged();
   }
   
   int rowCount(const QModelIndex &parent = QModelIndex()) const override {
     Q_UNUSED(parent);
-    return m_apps.count();
+    return int(m_rows.size());
   }
   
   QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override {
-    if (!index.isValid() || index.row() < 0 || index.row() >= m_apps.count())
+    if (!index.isValid() || index.row() < 0 || index.row() >= rowCount())
       return QVariant();
     
-    const AppInfo &app = m_apps[index.row()];
+    const AppInfo &app = appAt(index.row());
     switch (role) {
       case NameRole: return app.name;
       case CommandRole: return app.command;
       case IconRole: return app.icon;
       case LetterRole: return app.name.left(1).toUpper();
       case HeaderVisibleRole:
+        if (m_mostUsed && m_currentQuery.isEmpty()) return false;
         if (index.row() == 0) return true;
-        return app.name.left(1).toUpper() != m_apps[index.row() - 1].name.left(1).toUpper();
+        return app.name.left(1).toUpper() != appAt(index.row() - 1).name.left(1).toUpper();
       case DesktopFileRole: return app.desktopFilePath;
       case CategoriesRole: return app.categories;
       case TerminalRole: return app.terminal;
@@ -167,12 +231,68 @@ public:
     };
   }
   
+  // -------------------------------
+  // Incremental updates from AppIndex
+  // -------------------------------
+  void addApp(const AppInfo &app) {
+    auto pos = std::lower_bound(m_allApps.begin(), m_allApps.end(), app,
+                                [](const AppInfo &a, const AppInfo &b) {
+                                  return a.name.toLower() < b.name.toLower();
+                                });
+    const int at = int(pos - m_allApps.begin());
+    m_allApps.insert(at, app);
+    rebuildIndex(m_allApps);
+
+    // Everything behind the insertion point moved down by one
+    for (int &i : m_rows) {
+      if (i >= at)
+        ++i;
+    }
+    insertVisible(at);
+    resumeSearch();
+  }
+
+  void removeApp(const QString &desktopFilePath) {
+    int at = -1;
+    for (int i = 0; i < m_allApps.count(); ++i) {
+      if (m_allApps[i].desktopFilePath == desktopFilePath) {
+        at = i;
+        break;
+      }
+    }
+    if (at < 0)
+      return;
+
+    auto it = std::find(m_rows.begin(), m_rows.end(), at);
+    if (it != m_rows.end()) {
+      const int row = int(it - m_rows.begin());
+      beginRemoveRows(QModelIndex(), row, row);
+      m_rows.erase(it);
+      endRemoveRows();
+      headerChanged(row);
+    }
+
+    m_allApps.removeAt(at);
+    rebuildIndex(m_allApps);
+    for (int &i : m_rows) {
+      if (i > at)
+        --i;
+    }
+    resumeSearch();
+  }
+
+  void updateApp(const AppInfo &app) {
+    removeApp(app.desktopFilePath);
+    addApp(app);
+  }
+
   // -------------------------------
   // Search apps by name
   // -------------------------------
+  // Evaluated on the thread pool; only the newest result is published
   Q_INVOKABLE void search(const QString &query) {
     m_currentQuery = query.trimmed();
-    applyFilter();
+    scheduleSearch();
   }
   
   // -------------------------------
@@ -180,112 +300,353 @@ public:
   // -------------------------------
   Q_INVOKABLE void setCategoryFilter(const QString &category) {
     m_selectedCategory = category.trimmed();
-    applyFilter();
+    scheduleSearch();
+  }
+
+  // -------------------------------
+  // Fuzzy / typo-tolerant matching (on by default)
+  // -------------------------------
+  Q_INVOKABLE void setFuzzySearch(bool enabled) {
+    if (m_fuzzy == enabled)
+      return;
+    m_fuzzy = enabled;
+    if (!m_currentQuery.isEmpty())
+      scheduleSearch();
+  }
+
+  // -------------------------------
+  // "Most used" order of the full list
+  // -------------------------------
+  // Searches always rank by frecency within a score; this also applies it
+  // to the unfiltered list, which otherwise stays alphabetical
+  Q_INVOKABLE void setMostUsedSort(bool enabled) {
+    if (m_mostUsed == enabled)
+      return;
+    m_mostUsed = enabled;
+    scheduleSearch();
+  }
+
+  // -------------------------------
+  // Frecency from the launch log
+  // -------------------------------
+  void setLaunchLog(LaunchLog *log) {
+    m_launchLog = log;
+    m_frecency = frecencyFor(m_allApps);
+    connect(log, &LaunchLog::launched, this, [this]() {
+      m_frecency = frecencyFor(m_allApps);
+      if (!m_currentQuery.isEmpty() || m_mostUsed)
+        scheduleSearch();
+    });
   }
   
 private:
-  QList<AppInfo> m_apps;       // filtered list
-  QList<AppInfo> m_allApps;    // full list
+  QList<AppInfo> m_allApps;    // full list, sorted by name
+  std::vector<int> m_rows;     // visible rows, as indices into m_allApps
   QString m_currentQuery;      // current search query
   QString m_selectedCategory;  // selected category filter
+  bool m_fuzzy = true;
+  bool m_mostUsed = false;
+
+  // Per app in m_allApps, taken at one point in time; shared with workers
+  LaunchLog *m_launchLog = nullptr;
+  std::shared_ptr<const std::vector<double>> m_frecency;
+
+  // Search index over m_allApps, replaced (never modified) when it
+  // changes so that workers can keep using the one they started with
+  std::shared_ptr<const SearchIndex> m_search;
+  SearchIndex::State m_searchState;   // refinement base for the next query
+
+  // Every query, filter or list change takes a new generation; results
+  // from older ones are dropped and their workers stop early
+  quint64 m_generation = 0;
+  std::shared_ptr<std::atomic<quint64>> m_latestGeneration =
+    std::make_shared<std::atomic<quint64>>(0);
+  bool m_searchPending = false;
+  Async m_async;
+
+  // Short queries match most apps; the first screen is published before
+  // the rest is sorted
+  static constexpr int PartialRows = 48;
+
+  struct SearchResult {
+    quint64 generation = 0;
+    bool complete = false;
+    std::vector<int> rows;
+    SearchIndex::State state;
+  };
   
-  // scores search relevance
-  static int matchScore(const AppInfo &app, const QString &query)
-  {
-    if (query.isEmpty())
-      return 1000;
-    
-    QString q = query.toLower();
-    
-    auto scoreText = [&](const QString &text) {
-      if (text.isEmpty())
-        return 100;
-      
-      QString n = text.toLower();
-      
-      // Best: starts with query
-      if (n.startsWith(q))
-        return 0;
-      
-      // Next: any word starts with query
-      const QStringList words = n.split(QRegularExpression("\\s+"));
-      for (const QString &w : words) {
-        if (w.startsWith(q))
-          return 1;
-      }
-      
-      // Next: contains query
-      if (n.contains(q))
-        return 2;
-      
-      return 100;
-    };
-    
-    // 🔴 relevance order
-    int best = scoreText(app.name);                 // highest priority
-    best = qMin(best, scoreText(app.genericName) + 10); // slightly weaker
-    for (const QString &kw : app.keywords)
-      best = qMin(best, scoreText(kw) + 20);        // weakest
-      
-      return best;
+  const AppInfo &appAt(int row) const {
+    return m_allApps[m_rows[size_t(row)]];
   }
-  
-  
+
   // -------------------------------
-  // Apply search + category filter
+  // Place a single app into the visible list
   // -------------------------------
-  void applyFilter() {
-    beginResetModel();
-    m_apps.clear();
-    
-    struct ScoredApp {
-      AppInfo app;
-      int score;
-    };
-    
-    QList<ScoredApp> scored;
-    
-    for (const auto &app : m_allApps) {
-      // category filter
-      bool matchesCategory =
-      m_selectedCategory.isEmpty() ||
-      app.categories.contains(m_selectedCategory, Qt::CaseInsensitive);
-      
-      if (!matchesCategory)
+  void insertVisible(int at) {
+    if (!m_search->inCategory(at, m_selectedCategory))
+      return;
+
+    const SearchIndex::Query query = currentQuery();
+    const SearchIndex::Match match = m_search->match(at, query);
+    if (!m_currentQuery.isEmpty() && match.score >= SearchIndex::NoMatch)
+      return;
+
+    // Same ordering as the search: relevance, then name (list order)
+    int row = 0;
+    for (; row < rowCount(); ++row) {
+      if (SearchIndex::lessThan(match, m_search->match(m_rows[size_t(row)], query)))
+        break;
+    }
+
+    beginInsertRows(QModelIndex(), row, row);
+    m_rows.insert(m_rows.begin() + row, at);
+    endInsertRows();
+    headerChanged(row + 1);
+  }
+
+  // the letter header of a row depends on the row above it
+  void headerChanged(int row) {
+    if (row < 0 || row >= rowCount())
+      return;
+    emit dataChanged(index(row), index(row), { HeaderVisibleRole });
+  }
+
+  // -------------------------------
+  // Search index
+  // -------------------------------
+  void rebuildIndex(const QList<AppInfo> &apps = {}) {
+    auto index = std::make_shared<SearchIndex>();
+    index->build(apps);
+    m_search = std::move(index);
+    m_frecency = frecencyFor(apps);
+    m_searchState = {};
+    m_latestGeneration->store(++m_generation);
+  }
+
+  std::shared_ptr<const std::vector<double>> frecencyFor(const QList<AppInfo> &apps) const {
+    if (!m_launchLog)
+      return nullptr;
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    auto scores = std::make_shared<std::vector<double>>();
+    scores->reserve(size_t(apps.size()));
+    for (const AppInfo &app : apps)
+      scores->push_back(m_launchLog->frecency(app.desktopFilePath, now));
+    return scores;
+  }
+
+  SearchIndex::Query currentQuery() const {
+    SearchIndex::Query query(m_currentQuery, m_fuzzy);
+    query.frecency = m_frecency;
+    query.mostUsed = m_mostUsed;
+    return query;
+  }
+
+  // An app list change dropped the search that was in flight
+  void resumeSearch() {
+    if (m_searchPending)
+      scheduleSearch();
+  }
+
+  // Synchronous, for list changes
+  std::vector<int> filteredRows() {
+    const std::vector<SearchIndex::Match> matches = m_search->search(
+      currentQuery(), m_selectedCategory, -1, &m_searchState);
+    m_searchPending = false;
+
+    std::vector<int> rows;
+    rows.reserve(matches.size());
+    for (const SearchIndex::Match &m : matches)
+      rows.push_back(m.index);
+    return rows;
+  }
+
+  // -------------------------------
+  // Off-thread search + category filter
+  // -------------------------------
+  void scheduleSearch() {
+    const quint64 generation = ++m_generation;
+    m_latestGeneration->store(generation);
+    m_searchPending = true;
+
+    std::shared_ptr<const SearchIndex> index = m_search;
+    std::shared_ptr<std::atomic<quint64>> latest = m_latestGeneration;
+    const SearchIndex::Query query = currentQuery();
+    const QString category = m_selectedCategory;
+    const bool partialFirst = query.folded.size() < FuzzyMatcher::MinLength;
+
+    m_async.run(
+      [this, index, latest, query, category, partialFirst, generation,
+       state = m_searchState]() mutable -> SearchResult {
+        SearchResult result;
+        result.generation = generation;
+
+        auto cancelled = [&]() { return latest->load(std::memory_order_relaxed) != generation; };
+        std::vector<SearchIndex::Match> matches;
+        if (!index->collect(query, category, &state, &matches, cancelled))
+          return result;
+
+        auto rowsOf = [&](size_t count) {
+          std::vector<int> rows;
+          rows.reserve(count);
+          for (size_t i = 0; i < count; ++i)
+            rows.push_back(matches[i].index);
+          return rows;
+        };
+
+        if (partialFirst && matches.size() > size_t(PartialRows)) {
+          std::partial_sort(matches.begin(), matches.begin() + PartialRows, matches.end(),
+                            SearchIndex::lessThan);
+          QMetaObject::invokeMethod(this, [this, generation, rows = rowsOf(PartialRows)]() {
+            if (generation == m_generation)
+              applyRows(rows);
+          }, Qt::QueuedConnection);
+
+          if (cancelled())
+            return result;
+          std::sort(matches.begin() + PartialRows, matches.end(), SearchIndex::lessThan);
+        } else {
+          std::sort(matches.begin(), matches.end(), SearchIndex::lessThan);
+        }
+
+        result.rows = rowsOf(matches.size());
+        result.state = std::move(state);
+        result.complete = true;
+        return result;
+      },
+      [this](SearchResult result) {
+        if (!result.complete || result.generation != m_generation)
+          return;
+        m_searchPending = false;
+        m_searchState = std::move(result.state);
+        applyRows(result.rows);
+      });
+  }
+
+  // Emits the row removes, moves and inserts that turn the visible list
+  // into `target` instead of a model reset
+  void applyRows(const std::vector<int> &target) {
+    std::vector<char> inTarget(size_t(m_allApps.size()), 0);
+    for (int i : target)
+      inTarget[size_t(i)] = 1;
+
+    removeRowsWhere([&](int i) { return !inTarget[size_t(i)]; });
+    moveAndInsertRows(target);
+    headersChanged();
+  }
+
+  // -------------------------------
+  // Row diff
+  // -------------------------------
+  // Bottom-up, one signal per contiguous run
+  template <typename Pred>
+  void removeRowsWhere(Pred remove) {
+    for (int last = rowCount() - 1; last >= 0; --last) {
+      if (!remove(m_rows[size_t(last)]))
         continue;
-      
-      int score = matchScore(app, m_currentQuery);
-      
-      // reject non-matching search results
-      if (!m_currentQuery.isEmpty() && score >= 100)
+
+      int first = last;
+      while (first > 0 && remove(m_rows[size_t(first - 1)]))
+        --first;
+
+      beginRemoveRows(QModelIndex(), first, last);
+      m_rows.erase(m_rows.begin() + first, m_rows.begin() + last + 1);
+      endRemoveRows();
+      last = first;
+    }
+  }
+
+  // m_rows holds a subset of `target` in some order. The longest run
+  // already in target order stays put, every other row is moved once
+  // behind its predecessor, then the missing rows are inserted in runs.
+  void moveAndInsertRows(const std::vector<int> &target) {
+    std::vector<int> targetPos(size_t(m_allApps.size()), -1);
+    for (size_t t = 0; t < target.size(); ++t)
+      targetPos[size_t(target[t])] = int(t);
+
+    std::vector<char> present(target.size(), 0);
+    for (int i : m_rows)
+      present[size_t(targetPos[size_t(i)])] = 1;
+
+    // Longest increasing subsequence of target positions (patience sort)
+    const int n = rowCount();
+    std::vector<int> tails, tailRow, prevRow(size_t(n), -1);
+    for (int row = 0; row < n; ++row) {
+      const int pos = targetPos[size_t(m_rows[size_t(row)])];
+      auto it = std::lower_bound(tails.begin(), tails.end(), pos);
+      const size_t k = size_t(it - tails.begin());
+      if (k > 0)
+        prevRow[size_t(row)] = tailRow[k - 1];
+      if (it == tails.end()) {
+        tails.push_back(pos);
+        tailRow.push_back(row);
+      } else {
+        *it = pos;
+        tailRow[k] = row;
+      }
+    }
+
+    std::vector<char> stable(target.size(), 0);
+    for (int row = tailRow.empty() ? -1 : tailRow.back(); row >= 0; row = prevRow[size_t(row)])
+      stable[size_t(targetPos[size_t(m_rows[size_t(row)])])] = 1;
+
+    // Moves, in target order, so the predecessor is always in place
+    int predecessor = -1;
+    for (size_t t = 0; t < target.size(); ++t) {
+      if (!present[t])
         continue;
-      
-      scored.append({ app, score });
+
+      if (!stable[t]) {
+        auto rowOf = [this](int i) {
+          return int(std::find(m_rows.begin(), m_rows.end(), i) - m_rows.begin());
+        };
+        const int from = rowOf(target[t]);
+        const int after = predecessor < 0 ? -1 : rowOf(predecessor);
+        const int to = after + 1;   // destination in pre-move numbering
+
+        if (from != to && from != after) {
+          beginMoveRows(QModelIndex(), from, from, QModelIndex(), to);
+          const int i = m_rows[size_t(from)];
+          m_rows.erase(m_rows.begin() + from);
+          m_rows.insert(m_rows.begin() + (from < to ? to - 1 : to), i);
+          endMoveRows();
+        }
+      }
+      predecessor = target[t];
+    }
+
+    // Inserts
+    for (size_t t = 0; t < target.size();) {
+      if (present[t]) {
+        ++t;
+        continue;
+      }
+      size_t end = t;
+      while (end < target.size() && !present[end])
+        ++end;
+
+      beginInsertRows(QModelIndex(), int(t), int(end) - 1);
+      m_rows.insert(m_rows.begin() + qsizetype(t), target.begin() + qsizetype(t),
+                    target.begin() + qsizetype(end));
+      endInsertRows();
+      t = end;
     }
-    
-    // Sort by relevance score, then alphabetically
-    std::sort(scored.begin(), scored.end(),
-              [](const ScoredApp &a, const ScoredApp &b) {
-                if (a.score != b.score)
-                  return a.score < b.score;
-                return a.app.name.toLower() < b.app.name.toLower();
-              });
-    
-    for (const auto &s : scored)
-      m_apps.append(s.app);
-    
-    endResetModel();
   }
-  
-};
 
+  void headersChanged() {
+    if (rowCount() > 0)
+      emit dataChanged(index(0), index(rowCount() - 1), { HeaderVisibleRole });
+  }
+
+  static bool sameContent(const AppInfo &a, const AppInfo &b) {
+    return a.name == b.name && a.genericName == b.genericName &&
+           a.keywords == b.keywords && a.command == b.command &&
+           a.icon == b.icon && a.categories == b.categories &&
+           a.terminal == b.terminal && a.actions == b.actions;
+  }
 
-struct DesktopAction {
-    QString id;      // e.g. "NewWindow"
-    QString name;    // visible name
-    QString exec;    // Exec=
-    QString icon;    // Icon=
 };
+
+
 class DesktopActionModel : public QAbstractListModel {
     Q_OBJECT
 public:
@@ -324,6 +685,8 @@ public:
     }
 
     void setActions(const QList<DesktopAction> &actions) {
+        if (actions == m_actions)
+            return;
         beginResetModel();
         m_actions = actions;
         endResetModel();
@@ -339,7 +702,69 @@ private:
 class AppLauncher : public QObject {
   Q_OBJECT
 public:
-  explicit AppLauncher(QObject *parent = nullptr) : QObject(parent) {}
+  explicit AppLauncher(QObject *parent = nullptr)
+  : QObject(parent), m_launchLog(launchLogPath()), m_tracker(launchTrackerPath()) {
+    if (QFile::exists(legacyCachePath()))
+      QFile::remove(legacyCachePath());
+
+    m_index.setIconResolver(&AppIndex::resolveIcon);
+
+    connect(&m_index, &AppIndex::appAdded, this, &AppLauncher::appAdded);
+    connect(&m_index, &AppIndex::appChanged, this, &AppLauncher::appChanged);
+    connect(&m_index, &AppIndex::appRemoved, this, &AppLauncher::appRemoved);
+    connect(&m_index, &AppIndex::rescanRequired, this, &AppLauncher::rescanApplications);
+
+    // TryExec= results depend on what is installed; the entries are in
+    // memory, so this only filters them again
+    connect(&PathIndex::instance(), &PathIndex::changed, &m_index, &AppIndex::refilter);
+
+    // Prefetch only once focus has rested on an app
+    m_prefetchTimer.setSingleShot(true);
+    m_prefetchTimer.setInterval(PrefetchDwellMs);
+    connect(&m_prefetchTimer, &QTimer::timeout, this, [this]() {
+      m_prefetcher.prefetch(m_prefetchProgram);
+    });
+
+    // Launches go through the spawn helper, started with the Start menu
+    m_spawner.start();
+    connect(&m_spawner, &SpawnClient::spawned, this, [this](quint32 id, qint64 pid) {
+      const PendingSpawn spawn = m_spawnKeys.take(id);
+      if (spawn.key.isEmpty())
+        return;
+      m_tracker.spawned(spawn.launch, pid);
+      emit appSpawned(spawn.key, pid);
+    });
+    connect(&m_spawner, &SpawnClient::spawnFailed, this, [this](quint32 id, const QString &error) {
+      // Launcher (the Run dialog) shares the client without tracking
+      const PendingSpawn spawn = m_spawnKeys.take(id);
+      if (spawn.key.isEmpty())
+        return;
+      m_tracker.failed(spawn.launch);
+      qWarning() << "❌ launchApp:" << spawn.key << error;
+    });
+
+    // Keep the on-disk segments of the touched directories in step with
+    // the live index; written from its entries, nothing is parsed again
+    connect(&m_index, &AppIndex::indexChanged, this, [this](const QStringList &dirs) {
+      // Keyed right after the index read the files; anything changed
+      // since is in the next batch, which writes the segment again
+      struct Write {
+        QString dir;
+        QByteArray key;
+        AppSegment segment;
+      };
+      QList<Write> writes;
+      for (const QString &dir : dirs)
+        writes.append({dir, AppCache::segmentKey(dir), m_index.segment(dir)});
+
+      m_async.run([this, writes]() {
+                    for (const Write &w : writes)
+                      saveSegment(w.dir, w.key, w.segment);
+                    return true;
+                  },
+                  [](bool) {});
+    });
+  }
 
   // ------------------------------------
   // Get current user
@@ -366,169 +791,71 @@ public:
   // Async wrapper
   // ------------------------------------
   Q_INVOKABLE void listApplicationsAsync() {
-    m_async.run([this]() -> QVariantList { return listApplicationsSync(); },
-                [this](QVariantList apps) { emit applicationsLoaded(apps); });
+    m_async.run([this]() -> ScanResult {
+                  ScanResult scan;
+                  scan.apps = listApplicationsSync(&scan.segments);
+                  return scan;
+                },
+                [this](ScanResult scan) {
+                  m_index.reset(std::move(scan.segments), scan.apps);
+                  emit applicationsLoaded(scan.apps);
+                });
   }
 
   // ------------------------------------
   // Recheck for new apps on each showing
   // ------------------------------------
-  // Already exists, just make it callable from QML
+  // With a live inotify index the model is already current, so this only
+  // does work when inotify is unavailable.
   Q_INVOKABLE void refreshApplications() {
+      if (m_index.isWatching() && m_index.isSeeded())
+        return;
+      listApplicationsAsync();
+  }
+
+  // Forced full rescan (F5, inotify overflow)
+  Q_INVOKABLE void rescanApplications() {
       listApplicationsAsync();
   }
 
+  LaunchLog *launchLog() { return &m_launchLog; }
+  SpawnClient *spawnClient() { return &m_spawner; }
+  LaunchTracker *launchTracker() { return &m_tracker; }
+
   // ------------------------------------
   // SYNC implementation with caching
   // ------------------------------------
-  QVariantList listApplicationsSync() {
-    QString configDir =
-    QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation);
-    QDir().mkpath(configDir);
-    
-    QString cacheFile = configDir + "/apps_cache_v1.json";
-    QString hashFile = configDir + "/apps_cache_hash_v1.txt";
-    
-    // Compute current hash
-    QByteArray currentHash = computeAppsHash();
-    
-    // Load saved hash
-    QByteArray savedHash;
-    {
-      QFile hf(hashFile);
-      if (hf.open(QIODevice::ReadOnly)) {
-        savedHash = hf.readAll().trimmed();
-        hf.close();
-      }
-    }
-    
-    // If hashes match → use cache
-    if (savedHash == currentHash && QFile::exists(cacheFile)) {
-      QFile f(cacheFile);
-      if (f.open(QIODevice::ReadOnly)) {
-        QJsonDocument doc = QJsonDocument::fromJson(f.readAll());
-        f.close();
-        
-        if (doc.isArray()) {
-          qDebug() << "⚡ Loaded applications from cache.";
-          return doc.array().toVariantList();
-        }
-      }
-    }
-    
-    // Rescan .desktop files
-    qDebug() << "🔍 Scanning application directories...";
-    
-    QVariantList appList;
-    
-    QStringList dirs = {
-      "/usr/share/applications",
-      QStandardPaths::writableLocation(QStandardPaths::ApplicationsLocation)
-    };
-    
-    for (const QString &dirPath : dirs) {
-      QDir dir(dirPath);
-      if (!dir.exists()) continue;
-      
-      QStringList files = dir.entryList(QStringList() << "*.desktop", QDir::Files);
-      for (const QString &file : files) {
-        QString path = dir.absoluteFilePath(file);
-        QFile f(path);
-        if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) continue;
-        
-        QString name, genericName, exec, iconName;
-        QStringList categories;
-        QStringList keywords;
-        bool noDisplay = false;
-        bool inMainSection = false;
-        bool terminal = false;
-        
-        
-        while (!f.atEnd()) {
-          QString line = f.readLine().trimmed();
-          
-          if (line.startsWith('[')) {
-            if (line == "[Desktop Entry]")
-              inMainSection = true;
-            else if (line.startsWith("[Desktop Action"))
-              break;
-            else
-              inMainSection = false;
-            continue;
-          }
-          
-          if (!inMainSection) continue;
-          
-          if (line.startsWith("Name="))
-            name = line.mid(5).trimmed();
-          else if (line.startsWith("Exec=")) {
-            exec = line.mid(5).trimmed();
-            exec.replace(QRegularExpression("%[UuFfDdNnVvMm]"), "");
-          }
-          else if (line.startsWith("Icon="))
-            iconName = line.mid(5).trimmed();
-          else if (line.startsWith("Categories="))
-            categories = line.mid(11).split(';', Qt::SkipEmptyParts); // <-- PARSE CATEGORIES
-            else if (line.startsWith("Terminal="))
-              terminal = (line.mid(9).trimmed().toLower() == "true");
-            else if (line.startsWith("NoDisplay=") && line.mid(10).trimmed().toLower() == "true")
-              noDisplay = true;
-          else if (line.startsWith("GenericName="))
-            genericName = line.mid(12).trimmed();
-          else if (line.startsWith("Keywords="))
-            keywords = line.mid(9).split(';', Qt::SkipEmptyParts);
-          
-        }
-        
-        f.close();
-        
-        if (name.isEmpty() || exec.isEmpty() || noDisplay)
-          continue;
-        
-        QVariantMap app;
-        app["name"] = name;
-        app["genericName"] = genericName;
-        app["keywords"] = keywords;
-        app["command"] = exec;
-        app["icon"] = resolveIcon(iconName);
-        app["desktopFilePath"] = path;
-        app["categories"] = categories;
-        app["terminal"] = terminal;
-        
-        
-        appList.append(app);
-      }
-    }
-    
-    // Sort apps alphabetically
-    std::sort(appList.begin(), appList.end(),
-              [](const QVariant &a, const QVariant &b) {
-                return a.toMap()["name"].toString().toLower() <
-                b.toMap()["name"].toString().toLower();
-              });
-    
-    // Save cache
-    {
-      QFile f(cacheFile);
-      if (f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-        QJsonArray arr;
-        for (const QVariant &v : appList)
-          arr.append(QJsonObject::fromVariantMap(v.toMap()));
-        f.write(QJsonDocument(arr).toJson());
-        f.close();
-      }
-    }
-    
-    // Save hash
-    {
-      QFile hf(hashFile);
-      if (hf.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-        hf.write(currentHash);
-        hf.close();
+  // `segments` receives the per-directory scan results, in
+  // AppIndex::applicationDirs() order
+  QList<AppInfo> listApplicationsSync(QList<AppSegment> *segments = nullptr) {
+    QDir().mkpath(segmentDir());
+
+    // One segment per directory; only directories whose mtime moved since
+    // their segment was written are parsed again
+    QList<AppSegment> loaded;
+    int cached = 0;
+
+    for (const QString &dir : AppIndex::applicationDirs()) {
+      AppSegment segment;
+      if (AppCache::load(segmentPath(dir), AppCache::segmentKey(dir), &segment)) {
+        ++cached;
+      } else if (QFileInfo::exists(dir)) {
+        qDebug() << "🔍 Scanning" << dir;
+        segment = scanSegment(dir);
       }
+      loaded.append(std::move(segment));
     }
-    
-    qDebug() << "✅ Applications scanned and cached.";
+
+    if (segments)
+      *segments = loaded;
+
+    QList<AppInfo> appList = AppIndex::mergeSegments(std::move(loaded));
+    qDebug() << "⚡ Applications loaded:" << appList.size() << "apps,"
+             << cached << "of" << AppIndex::applicationDirs().size() << "directories from cache";
+
+    if (qEnvironmentVariableIsSet("WIN8START_EXPORT_APPS_JSON"))
+      AppCache::exportJson(jsonExportPath(), appList);
+
     return appList;
   }
   
@@ -537,117 +864,69 @@ public:
   // Icon resolver
   // ------------------------------------
   Q_INVOKABLE QString resolveIcon(const QString &name) const {
-    if (name.isEmpty())
-      return "qrc:/icons/placeholder.svg";
-
-    if (QFile::exists(name))
-      return "file://" + name;
-
-    QString home = QDir::homePath();
-    const QStringList iconDirs = {
-        "/usr/share/icons/hicolor/scalable/apps/",
-        "/usr/share/icons/hicolor/256x256/apps/",
-        "/usr/share/icons/hicolor/128x128/apps/",
-        "/usr/share/icons/hicolor/64x64/apps/",
-        "/usr/share/icons/hicolor/48x48/apps/",
-        "/usr/share/pixmaps/",
-        "/usr/share/icons/breeze/apps/64/",
-        "/usr/share/icons/breeze/apps/48/",
-        "/usr/share/icons/breeze/apps/32/",
-        home + "/.local/share/icons/hicolor/256x256/apps/"};
-
-    for (const QString &dir : iconDirs) {
-      QString pngPath = dir + name + ".png";
-      QString svgPath = dir + name + ".svg";
-      if (QFile::exists(pngPath))
-        return "file://" + pngPath;
-      if (QFile::exists(svgPath))
-        return "file://" + svgPath;
-    }
-
-    return "qrc:/icons/placeholder.svg";
-  }
-
-  QList<DesktopAction> parseDesktopActions(const QString &desktopFile) {
-      QList<DesktopAction> actions;
-      QFile f(desktopFile);
-      if (!f.open(QIODevice::ReadOnly | QIODevice::Text))
-          return actions;
-
-      QString currentId;
-      DesktopAction current;
-      bool inAction = false;
-
-      while (!f.atEnd()) {
-          QString line = f.readLine().trimmed();
-
-          if (line.startsWith("[Desktop Action ")) {
-              if (inAction && !current.name.isEmpty() && !current.exec.isEmpty())
-                  actions.append(current);
-
-              current = DesktopAction{};
-              currentId = line.mid(16, line.size() - 17);
-              current.id = currentId;
-              inAction = true;
-              continue;
-          }
-
-          if (line.startsWith('[')) {
-              if (inAction && !current.name.isEmpty() && !current.exec.isEmpty())
-                  actions.append(current);
-              inAction = false;
-              continue;
-          }
-
-          if (!inAction)
-              continue;
-
-          if (line.startsWith("Name="))
-              current.name = line.mid(5).trimmed();
-          else if (line.startsWith("Exec=")) {
-              current.exec = line.mid(5).trimmed();
-              current.exec.replace(QRegularExpression("%[UuFfDdNnVvMm]"), "");
-          } else if (line.startsWith("Icon="))
-              current.icon = resolveIcon(line.mid(5).trimmed());
-      }
-
-      if (inAction && !current.name.isEmpty() && !current.exec.isEmpty())
-          actions.append(current);
-
-      return actions;
+    return AppIndex::resolveIcon(name);
   }
+
+  // ------------------------------------
+  // Context menu actions
+  // ------------------------------------
+  // Parsed with the entry by the index; filled before the menu pops up
   Q_INVOKABLE void loadDesktopActions(const QString &desktopFile,
                                       DesktopActionModel *model) {
-    if (!model)
-      return;
+    if (model)
+      model->setActions(m_index.actions(desktopFile));
+  }
 
-    QPointer<DesktopActionModel> safeModel(model);
 
-    m_async.run(
-      [this, desktopFile]() {
-        return parseDesktopActions(desktopFile);
-      },
-      [safeModel](QList<DesktopAction> actions) {
-        if (safeModel)
-          safeModel->setActions(actions);
-      });}
 
+  // ------------------------------------
+  // Run-command completion
+  // ------------------------------------
+  // Executables on PATH starting with `prefix`, from the in-memory index
+  Q_INVOKABLE QStringList completeCommand(const QString &prefix, int limit = 8) const {
+    return PathIndex::instance().complete(prefix, limit);
+  }
+
+  // ------------------------------------
+  // Hover / focus prefetch
+  // ------------------------------------
+  // The pointer or keyboard focus is on an app: read its executable and
+  // libraries into the page cache if focus stays there. Moving on cancels.
+  Q_INVOKABLE void prefetchApp(const QString &command) {
+    const QStringList parts = QProcess::splitCommand(DesktopEntry::stripFieldCodes(command));
+    m_prefetchProgram = parts.isEmpty() ? QString() : resolveExecutable(parts.first());
+
+    m_prefetcher.cancel();
+    if (m_prefetchProgram.isEmpty())
+      m_prefetchTimer.stop();
+    else
+      m_prefetchTimer.start();
+  }
 
+  Q_INVOKABLE void cancelPrefetch() {
+    m_prefetchTimer.stop();
+    m_prefetcher.cancel();
+  }
 
   // ------------------------------------
   // Launch application
   // ------------------------------------
-  Q_INVOKABLE void launchApp(const QString &command, bool terminal) {
+  // `desktopFile` keys the launch in the frecency log; without one the
+  // command is used
+  Q_INVOKABLE void launchApp(const QString &command, bool terminal = false,
+                             const QString &desktopFile = QString()) {
     if (command.isEmpty()) {
       qWarning() << "⚠️ launchApp: Empty command.";
       return;
     }
+
+    // The launch reads the files itself now
+    m_prefetchTimer.stop();
     
-    QString cmd = command.trimmed();
-    cmd.replace(QRegularExpression("%[uUfFdDnNvVmM]"), "");
+    QString cmd = DesktopEntry::stripFieldCodes(command);
     
     // Expand env vars
-    QRegularExpression envVarPattern(R"(\$(\w+)|\$\{([^}]+)\})");
+    static const QRegularExpression envVarPattern(R"(\$(\w+)|\$\{([^}]+)\})");
     QRegularExpressionMatchIterator it = envVarPattern.globalMatch(cmd);
     while (it.hasNext()) {
         auto match = it.next();
@@ -664,9 +943,7 @@ public:
         return;
 
     QString program = parts.takeFirst();
-    QString programPath = QFile::exists(program)
-                              ? program
-                              : QStandardPaths::findExecutable(program);
+    QString programPath = resolveExecutable(program);
 
     if (programPath.isEmpty()) {
         qWarning() << "❌ launchApp: Executable not found:" << program;
@@ -675,7 +952,7 @@ public:
 
     // 🟢 TERMINAL HANDLING
     if (terminal) {
-      QString terminalExe = QStandardPaths::findExecutable("alacritty");
+      QString terminalExe = resolveExecutable("alacritty");
       
       if (terminalExe.isEmpty()) {
         qWarning() << "❌ Alacritty not found";
@@ -686,10 +963,19 @@ public:
       termArgs << "-e" << programPath;
       termArgs << parts;
       
-      QProcess::startDetached(terminalExe, termArgs);
+      parts = QStringList{terminalExe} + termArgs;
     } else {
-      QProcess::startDetached(programPath, parts);
+      parts.prepend(programPath);
     }
+
+    // Spawned by the helper; the pid comes back as appSpawned()
+    const QString key = desktopFile.isEmpty() ? command : desktopFile;
+    const quint64 launch = m_tracker.begin(key, LaunchTracker::appIdsFor(desktopFile, programPath));
+    const QString cwd = desktopFile.isEmpty() ? QString() : m_index.workingDir(desktopFile);
+    m_spawnKeys.insert(m_spawner.spawn(parts, cwd), {key, launch});
+
+    // After the start, and without touching the disk on this thread
+    m_launchLog.record(key);
 }
 
 
@@ -733,35 +1019,86 @@ public:
   }
 
 signals:
-  void applicationsLoaded(const QVariantList &apps);
+  void applicationsLoaded(const QList<AppInfo> &apps);
+  void appAdded(const AppInfo &app);
+  void appChanged(const AppInfo &app);
+  void appRemoved(const QString &desktopFilePath);
+  void appSpawned(const QString &key, qint64 pid);   // key as in the launch log
 
 private:
+  struct ScanResult {
+    QList<AppSegment> segments;
+    QList<AppInfo> apps;
+  };
+
   Async m_async;
+  AppIndex m_index;
+  QMutex m_cacheMutex;
+  LaunchLog m_launchLog;
+  LaunchTracker m_tracker;
+  SpawnClient m_spawner;
+
+  static constexpr int PrefetchDwellMs = 150;
+  Prefetcher m_prefetcher;
+  QTimer m_prefetchTimer;
+  QString m_prefetchProgram;
+
+  struct PendingSpawn {
+    QString key;          // as in the launch log
+    quint64 launch = 0;   // LaunchTracker id
+  };
+  QHash<quint32, PendingSpawn> m_spawnKeys;   // spawn request -> launch
+
+  static QString launchLogPath() {
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation);
+    QDir().mkpath(dir);
+    return dir + "/launch_log.bin";
+  }
+
+  static QString launchTrackerPath() {
+    return QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation) +
+           "/launch_latency.json";
+  }
+
+  static QString segmentDir() {
+    return QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation) +
+           "/apps_cache";
+  }
+
+  static QString segmentPath(const QString &dir) {
+    return segmentDir() + "/" + QString(dir).replace('/', '_') + ".bin";
+  }
+
+  // Before the per-directory segments; removed once
+  static QString legacyCachePath() {
+    return QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation) +
+           "/apps_cache_v2.bin";
+  }
+
+  // Debug export, written only when WIN8START_EXPORT_APPS_JSON is set
+  static QString jsonExportPath() {
+    return QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation) +
+           "/apps_cache_v1.json";
+  }
 
-  
   // ------------------------------------
-  // Directory hash for caching
+  // Parse one directory and write its segment
   // ------------------------------------
-  QByteArray computeAppsHash() const {
-    QCryptographicHash md5(QCryptographicHash::Md5);
+  AppSegment scanSegment(const QString &dir) {
+    // Taken before scanning, so a change during the scan leaves a stale key
+    const QByteArray key = AppCache::segmentKey(dir);
 
-    QStringList dirs = {
-        "/usr/share/applications",
-        QStandardPaths::writableLocation(QStandardPaths::ApplicationsLocation)};
+    AppSegment segment = AppIndex::scanDirectory(dir, &AppIndex::resolveIcon);
 
-    for (const QString &dir : dirs) {
-      QDir d(dir);
-      if (!d.exists())
-        continue;
-
-      QFileInfoList list = d.entryInfoList(QDir::Files | QDir::NoDotAndDotDot);
-      for (const QFileInfo &fi : list) {
-        md5.addData(fi.fileName().toUtf8());
-        md5.addData(QByteArray::number(fi.lastModified().toSecsSinceEpoch()));
-      }
-    }
+    saveSegment(dir, key, segment);
+    return segment;
+  }
 
-    return md5.result().toHex();
+  void saveSegment(const QString &dir, const QByteArray &key, const AppSegment &segment) {
+    // Pool threads may race on the same directory, so serialize
+    QMutexLocker locker(&m_cacheMutex);
+    if (!AppCache::save(segmentPath(dir), key, segment))
+      qWarning() << "⚠️ Failed to write application cache:" << segmentPath(dir);
   }
 };
 
@@ -770,6 +1107,8 @@ class Launcher : public QObject {
 public:
   explicit Launcher(QObject *parent = nullptr) : QObject(parent) {}
 
+  void setSpawnClient(SpawnClient *spawner) { m_spawner = spawner; }
+
   // QML: Launcher.launch("Win8Settings")
   Q_INVOKABLE void launch(const QString &target) {
     if (target.isEmpty())
@@ -789,65 +1128,45 @@ public:
   }
 
 private:
-  void launchCommand(const QString &cmd) {
-    QString cleaned = cmd;
-    cleaned.replace(QRegularExpression("%[uUfFdDnNvVmM]"), "");
+  // `workingDir` is the entry's Path=; empty for $HOME
+  void launchCommand(const QString &cmd, const QString &workingDir = QString()) {
+    const QString cleaned = DesktopEntry::stripFieldCodes(cmd);
 
     QStringList parts = QProcess::splitCommand(cleaned);
     if (parts.isEmpty())
       return;
 
     QString program = parts.takeFirst();
-    QString execPath = QFile::exists(program)
-                           ? program
-                           : QStandardPaths::findExecutable(program);
+    QString execPath = resolveExecutable(program);
 
     if (execPath.isEmpty()) {
       qWarning() << "Launcher: executable not found:" << program;
       return;
     }
 
-    QProcess::startDetached(execPath, parts);
+    if (m_spawner)
+      m_spawner->spawn(QStringList{execPath} + parts, workingDir);
+    else
+      QProcess::startDetached(execPath, parts,
+                              workingDir.isEmpty() ? QDir::homePath() : workingDir);
   }
 
+  SpawnClient *m_spawner = nullptr;
+
   void launchDesktopFile(const QString &path) {
-    QFile f(path);
-    if (!f.open(QIODevice::ReadOnly | QIODevice::Text))
+    DesktopEntry entry;
+    if (!entry.load(path))
       return;
 
-    QString exec;
-    bool inMain = false;
-
-    while (!f.atEnd()) {
-      QString line = f.readLine().trimmed();
-
-      if (line == "[Desktop Entry]") {
-        inMain = true;
-        continue;
-      }
-      if (line.startsWith('['))
-        inMain = false;
-
-      if (inMain && line.startsWith("Exec=")) {
-        exec = line.mid(5).trimmed();
-        exec.replace(QRegularExpression("%[uUfFdDnNvVmM]"), "");
-        break;
-      }
-    }
-    f.close();
-
+    const QString exec = entry.string(DesktopEntry::MainGroup, "Exec");
     if (!exec.isEmpty())
-      launchCommand(exec);
+      launchCommand(exec, entry.string(DesktopEntry::MainGroup, "Path"));
   }
 
   QString findDesktopFile(const QString &name) const {
     QString desktopName = name.endsWith(".desktop") ? name : name + ".desktop";
 
-    QStringList dirs = {
-        "/usr/share/applications",
-        QStandardPaths::writableLocation(QStandardPaths::ApplicationsLocation)};
-
-    for (const QString &dir : dirs) {
+    for (const QString &dir : AppIndex::applicationDirs()) {
       QString path = dir + "/" + desktopName;
       if (QFile::exists(path))
         return path;
@@ -857,25 +1176,8 @@ private:
 };
 
 // ----------------------------
-// Tile Model (JSON persistent) - Async-enabled
+// Tile Model (persistent through TileStore)
 // ----------------------------
-struct Tile {
-  QString name;
-  QString icon;
-  QString desktopFile;
-  QString command;
-  bool terminal = false;
-  double modelX;
-  double modelY;
-  QString size;
-  QString color;
-  QString qmlPath;   // external tile UI (optional)
-  bool qmlEnabled = false;
-  int qmlGeneration = 0;
-};
-
-Q_DECLARE_METATYPE(Tile)
-
 class TileModel : public QAbstractListModel {
   Q_OBJECT
 
@@ -897,8 +1199,18 @@ public:
   };
 
   TileModel(QObject *parent = nullptr)
-  : QAbstractListModel(parent) {
-    loadAsync();
+  : QAbstractListModel(parent), m_store(storePath(), jsonPath()) {
+    // Synchronous, so the tiles are there on the first frame
+    QElapsedTimer timer;
+    timer.start();
+    m_tiles = m_store.load();
+    qDebug() << "✅ TileModel loaded:" << m_tiles.size() << "in" << timer.nsecsElapsed() / 1000 << "us";
+
+    m_logicSyncTimer.setSingleShot(true);
+    m_logicSyncTimer.setInterval(0);
+    connect(&m_logicSyncTimer, &QTimer::timeout, this, &TileModel::syncLogic);
+
+    syncLogic();
   }
 
   // -------------------------------------------------
@@ -961,6 +1273,7 @@ public:
 
     m_tiles[index].modelX = x;
     m_tiles[index].modelY = y;
+    placeOnGrid(index);
 
     emit dataChanged(
       this->index(index),
@@ -976,6 +1289,7 @@ public:
       return;
 
     m_tiles[index].size = size;
+    placeOnGrid(index);
     emit dataChanged(
       this->index(index),
                      this->index(index),
@@ -991,11 +1305,119 @@ public:
 
     beginRemoveRows(QModelIndex(), index, index);
     m_tiles.removeAt(index);
+    rebuildGrid();    // later rows moved up; views query it on rowsRemoved
     endRemoveRows();
+    syncLogic();
 
     saveAsync();
   }
 
+  // -------------------------------------------------
+  // Tile geometry (QML invokable)
+  // -------------------------------------------------
+  // Positions stay in pixels in the model; the occupancy grid works in
+  // cells of `cellSize` pixels and is rebuilt whenever the surface size
+  // changes.
+
+  Q_INVOKABLE void setGrid(double cellSize, int columns, int rows) {
+    if (cellSize <= 0)
+      return;
+    if (qFuzzyCompare(cellSize, m_cellSize) && columns == m_grid.columns() && rows == m_grid.rows())
+      return;
+    m_cellSize = cellSize;
+    m_grid.reset(columns, rows);
+    rebuildGrid();
+    emit geometryChanged();
+  }
+
+  // Pixel bounds of the cells a tile covers
+  Q_INVOKABLE QRectF tileRect(int index) const {
+    if (index < 0 || index >= m_tiles.count())
+      return {};
+    const Tile &t = m_tiles[index];
+    const QSize span = cellSpan(t.size);
+    const double cell = m_cellSize > 0 ? m_cellSize : 1;
+    return QRectF(t.modelX, t.modelY, span.width() * cell, span.height() * cell);
+  }
+
+  // Tiles overlapping the horizontal range [x0, x1), in model order, from
+  // the grid columns in that range; all of them until the grid is known
+  QList<int> tilesBetween(double x0, double x1) const {
+    if (m_cellSize <= 0) {
+      QList<int> tiles;
+      for (int i = 0; i < m_tiles.count(); ++i)
+        tiles << i;
+      return tiles;
+    }
+    const int first = int(std::floor(x0 / m_cellSize));
+    const int last = int(std::ceil(x1 / m_cellSize)) - 1;
+    if (last < first)
+      return {};
+    return m_grid.tilesInColumns(first, last);
+  }
+
+  Q_INVOKABLE bool isCellFree(int col, int row, int exclude = -1) const {
+    return m_grid.isFree(col, row, exclude);
+  }
+
+  // Free top-left position for a width x height (pixels) tile at or near
+  // (x, y); null when there is no room within 4 cells
+  Q_INVOKABLE QVariant nearestFreeSlot(double x, double y, double width, double height,
+                                       int exclude = -1) const {
+    if (m_cellSize <= 0)
+      return {};
+    const TileRect rect{qRound(x / m_cellSize), qRound(y / m_cellSize),
+                        spanOf(width), spanOf(height)};
+    return toPixels(m_grid.nearestFree(rect, 4, exclude));
+  }
+
+  // First free position, filling columns top to bottom, left to right
+  Q_INVOKABLE QVariant nextFreeSlot(double width, double height) const {
+    if (m_cellSize <= 0)
+      return {};
+    return toPixels(m_grid.firstFree(spanOf(width), spanOf(height)));
+  }
+
+  // Tile to focus from `index` for an arrow key; -1 when there is none
+  Q_INVOKABLE int neighbour(int index, int dx, int dy) const {
+    return m_grid.neighbour(index, dx, dy);
+  }
+
+  // Close the vertical gaps in the group of columns around `index`
+  Q_INVOKABLE void compactGroup(int index) {
+    const auto moves = m_grid.compactGroup(index);
+    for (const auto &[tile, cell] : moves) {
+      m_tiles[tile].modelX = cell.x() * m_cellSize;
+      m_tiles[tile].modelY = cell.y() * m_cellSize;
+      placeOnGrid(tile);
+      emit dataChanged(this->index(tile), this->index(tile), { ModelXRole, ModelYRole });
+    }
+    if (!moves.isEmpty())
+      saveAsync();
+  }
+
+  // Snap tiles that are off the grid by at most `tolerance` pixels
+  Q_INVOKABLE void snapTiles(double tolerance) {
+    if (m_cellSize <= 0)
+      return;
+    bool moved = false;
+    for (int i = 0; i < m_tiles.count(); ++i) {
+      Tile &t = m_tiles[i];
+      const double x = qRound(t.modelX / m_cellSize) * m_cellSize;
+      const double y = qRound(t.modelY / m_cellSize) * m_cellSize;
+      const double dx = qAbs(x - t.modelX), dy = qAbs(y - t.modelY);
+      if ((dx < 0.5 && dy < 0.5) || dx > tolerance || dy > tolerance)
+        continue;
+      t.modelX = x;
+      t.modelY = y;
+      placeOnGrid(i);
+      emit dataChanged(index(i), index(i), { ModelXRole, ModelYRole });
+      moved = true;
+    }
+    if (moved)
+      saveAsync();
+  }
+
   // -------------------------------------------------
   // Async add from .desktop file
   // -------------------------------------------------
@@ -1014,43 +1436,17 @@ public:
         t.modelY = dropY;
         t.size = "medium";
 
-        QFile f(filePath);
-        if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        DesktopEntry entry;
+        if (!entry.load(filePath)) {
           t.name = QFileInfo(filePath).baseName();
           return t;
         }
 
-        bool inMainSection = false;
-
-        while (!f.atEnd()) {
-          QString line = f.readLine().trimmed();
-
-          if (line.startsWith('[')) {
-            if (line == "[Desktop Entry]") {
-              inMainSection = true;
-            } else if (line.startsWith("[Desktop Action")) {
-              break;
-            } else {
-              inMainSection = false;
-            }
-            continue;
-          }
-
-          if (!inMainSection)
-            continue;
-
-          if (line.startsWith("Name="))
-            t.name = line.mid(5).trimmed();
-          else if (line.startsWith("Icon="))
-            t.icon = line.mid(5).trimmed();
-          else if (line.startsWith("Terminal="))
-            t.terminal = (line.mid(9).trimmed().toLower() == "true");
-          else if (line.startsWith("Exec=")) {
-            t.command = line.mid(5).trimmed();
-            t.command.replace(
-              QRegularExpression("%[UuFfDdNnVvMm]"), "");
-          }
-        }
+        const QByteArrayView group = DesktopEntry::MainGroup;
+        t.name = entry.localeString(group, "Name");
+        t.icon = entry.string(group, "Icon");
+        t.terminal = entry.boolean(group, "Terminal");
+        t.command = DesktopEntry::stripFieldCodes(entry.string(group, "Exec"));
 
         if (t.name.isEmpty())
           t.name = QFileInfo(filePath).baseName();
@@ -1060,6 +1456,7 @@ public:
       [this](Tile t) {
         beginInsertRows(QModelIndex(), m_tiles.count(), m_tiles.count());
         m_tiles.append(t);
+        placeOnGrid(m_tiles.count() - 1);
         endInsertRows();
 
         saveAsync();
@@ -1097,6 +1494,7 @@ public:
       [this](Tile t) {
         beginInsertRows(QModelIndex(), m_tiles.count(), m_tiles.count());
         m_tiles.append(t);
+        placeOnGrid(m_tiles.count() - 1);
         endInsertRows();
         saveAsync();
         qDebug() << "✅ Added tile from AppModel:" << t.name;
@@ -1141,9 +1539,6 @@ public:
       ) + "/tiles";
     }
     
-    // Add this member to TileModel
-    QSet<QString> m_logicRan; // Add this to your TileModel private members
-     
      Q_INVOKABLE void setTileQml(int index, const QString &path)
      {
        if (index < 0 || index >= m_tiles.count())
@@ -1161,43 +1556,22 @@ public:
        }
        
        QFileInfo qmlInfo(qmlPath);
-       QDir tileDir = qmlInfo.dir();
        
        if (!qmlInfo.exists())
          return;
        
        // ---- Assign QML path (only if changed) ----
-       if (m_tiles[index].qmlPath != qmlPath) {
-         m_tiles[index].qmlPath = qmlPath;
-         emit dataChanged(this->index(index), this->index(index), { QmlPathRole });
-         qDebug() << "🧩 Tile QML loaded:" << m_tiles[index].name;
-       }
-       
-       if (!m_tiles[index].qmlEnabled)
+       // Delegates call this on every create and recycle, so the logic
+       // is only looked at when the path is new
+       if (m_tiles[index].qmlPath == qmlPath)
          return;
-       
-       // ---- Run logic.py once ----
-       QString logicPath = tileDir.filePath("logic.py");
-       if (QFile::exists(logicPath) && !m_logicRan.contains(logicPath)) {
-         m_logicRan.insert(logicPath);
-         
-         qDebug() << "⚡ logic.py running for tile:" << m_tiles[index].name;
-         
-         QProcess *p = new QProcess(this);
-         p->setProgram("python3");
-         p->setArguments({ logicPath });
-         p->setWorkingDirectory(tileDir.absolutePath());
-         
-         connect(p, &QProcess::finished, this, [p](int, QProcess::ExitStatus) {
-           p->deleteLater();
-         });
-         
-         connect(p, &QProcess::errorOccurred, this, [p](QProcess::ProcessError) {
-           p->deleteLater();
-         });
-         
-         p->start();
-       }
+
+       m_tiles[index].qmlPath = qmlPath;
+       emit dataChanged(this->index(index), this->index(index), { QmlPathRole });
+       qDebug() << "🧩 Tile QML loaded:" << m_tiles[index].name;
+
+       // ---- logic.py, if the live tile is on ----
+       syncLogic();
      }
      
      Q_INVOKABLE void setTileQmlEnabled(int index, bool enabled)
@@ -1212,32 +1586,8 @@ public:
        emit dataChanged(this->index(index), this->index(index), { QmlEnabledRole });
        saveAsync();
        
-       if (enabled && !m_tiles[index].qmlPath.isEmpty()) {
-         QString qmlPath = m_tiles[index].qmlPath;
-         QFileInfo qmlInfo(qmlPath);
-         QDir tileDir = qmlInfo.dir();
-         QString logicPath = tileDir.filePath("logic.py");
-         
-         if (QFile::exists(logicPath) && !m_logicRan.contains(logicPath)) {
-           m_logicRan.insert(logicPath);
-           qDebug() << "⚡ logic.py running for tile:" << m_tiles[index].name;
-           
-           QProcess *p = new QProcess(this);
-           p->setProgram("python3");
-           p->setArguments({ logicPath });
-           p->setWorkingDirectory(tileDir.absolutePath());
-           
-           connect(p, &QProcess::finished, this, [p](int, QProcess::ExitStatus) {
-             p->deleteLater();
-           });
-           
-           connect(p, &QProcess::errorOccurred, this, [p](QProcess::ProcessError) {
-             p->deleteLater();
-           });
-           
-           p->start();
-         }
-       }
+       // Starts or kills the tile's logic.py
+       syncLogic();
      }
      
      Q_INVOKABLE void toggleTileQml(int index)
@@ -1252,101 +1602,113 @@ public:
        
        m_tiles[index].qmlGeneration++;
        emit dataChanged(this->index(index), this->index(index), { QmlGenerationRole });
+
+       // A plugin may have been dropped in since; one sync for all the
+       // tiles reloaded together
+       const Tile &t = m_tiles[index];
+       if (t.qmlEnabled && !t.qmlPath.isEmpty()) {
+         m_plugins.reload(QFileInfo(t.qmlPath).absolutePath());
+         m_logicSyncTimer.start();
+       }
      }
      
     
 
     // -------------------------------------------------
-    // Async load / save
+    // Save
     // -------------------------------------------------
 
-    void loadAsync() {
-      m_async.run(
-        [this]() -> QList<Tile> {
-          QList<Tile> tiles;
-          QFile file(jsonPath());
-          if (!file.open(QIODevice::ReadOnly))
-            return tiles;
-
-          QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
-          for (const auto &v : doc.array()) {
-            QJsonObject o = v.toObject();
-            Tile t;
-            t.name        = o["name"].toString();
-            t.icon        = o["icon"].toString();
-            t.desktopFile = o["desktopFile"].toString();
-            t.command     = o["command"].toString();
-            t.modelX      = o["modelX"].toDouble();
-            t.modelY      = o["modelY"].toDouble();
-            t.size        = o["size"].toString("medium");
-            t.terminal    = o.value("terminal").toBool(false);
-            t.color       = o.value("color").toString("");
-            t.qmlPath = o.value("qmlPath").toString("");
-            t.qmlEnabled = o.value("qmlEnabled").toBool(false);
-            tiles.append(t);
-          }
-          return tiles;
-        },
-        [this](QList<Tile> tiles) {
-          beginResetModel();
-          m_tiles = tiles;
-          endResetModel();
-          qDebug() << "✅ TileModel loaded:" << m_tiles.size();
-        }
-      );
+    // Coalesced and written atomically by the store
+    void saveAsync() {
+      m_store.save(m_tiles);
     }
 
-    void saveAsync() const {
-      QList<Tile> tiles = m_tiles;
-      
-      // 🔽 SORT: lowest modelX first, then lowest modelY
-      std::sort(tiles.begin(), tiles.end(),
-                [](const Tile &a, const Tile &b) {
-                  if (!qFuzzyCompare(a.modelX, b.modelX))
-                    return a.modelX < b.modelX;
-                  return a.modelY < b.modelY;
-                }
-      );
-      
-      Async *async = new Async(const_cast<TileModel *>(this));
-      
-      async->run(
-        [tiles, this]() -> bool {
-          QJsonArray arr;
-          for (const auto &t : tiles) {
-            QJsonObject o;
-            o["name"]        = t.name;
-            o["icon"]        = t.icon;
-            o["desktopFile"] = t.desktopFile;
-            o["command"]     = t.command;
-            o["modelX"]      = t.modelX;
-            o["modelY"]      = t.modelY;
-            o["size"]        = t.size;
-            o["terminal"]    = t.terminal;
-            o["color"]       = t.color;
-            o["qmlPath"]     = t.qmlPath;
-            o["qmlEnabled"]  = t.qmlEnabled;
-            arr.append(o);
-          }
-          
-          QFile file(jsonPath());
-          QDir().mkpath(QFileInfo(file).absolutePath());
-          if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
-            return false;
-          
-          file.write(QJsonDocument(arr).toJson(QJsonDocument::Indented));
-          return true;
-        },
-        [](bool) {}
-      );
+    // Live tile scripts and plugins, paused while Start is hidden
+    void setLogicPaused(bool paused) {
+      m_supervisor.setPaused(paused);
+      m_plugins.setPaused(paused);
     }
+
+    // Data pushed by live tile logic, for the tiles' QML
+    LiveTileBus *liveTiles() { return &m_bus; }
     
 
+signals:
+  void geometryChanged();   // new cell size or surface size
+
 private:
   QList<Tile> m_tiles;
   Async m_async;
+  TileStore m_store;
+  TileGrid m_grid;
+  double m_cellSize = 0;
+  LiveTileBus m_bus;
+  LiveTilePluginHost m_plugins{&m_bus};   // after the bus: providers go first
+  TileSupervisor m_supervisor;
+  QTimer m_logicSyncTimer;                // coalesces reloads
+
+  // Every enabled live tile gets a bus socket and its native plugin, or
+  // else its logic.py; new logic is started and the rest is stopped
+  void syncLogic() {
+    QSet<QString> dirs;
+    for (const Tile &t : m_tiles) {
+      if (t.qmlEnabled && !t.qmlPath.isEmpty())
+        dirs.insert(QFileInfo(t.qmlPath).absolutePath());
+    }
+    m_bus.sync(dirs);
+    m_plugins.sync(dirs);
+
+    QHash<QString, QString> scripts;
+    for (const QString &dir : std::as_const(dirs)) {
+      const QString logicPath = dir + "/logic.py";
+      if (!m_plugins.isRunning(dir) && QFile::exists(logicPath))
+        scripts.insert(logicPath, m_bus.socketPath(dir));
+    }
+    m_supervisor.sync(scripts);
+  }
+
+  // Cells covered by a tile of `size`; the QML sizes are these spans
+  // minus the gap
+  static QSize cellSpan(const QString &size) {
+    if (size == "small")  return {1, 1};
+    if (size == "large")  return {4, 2};
+    if (size == "xlarge") return {4, 4};
+    return {2, 2};
+  }
+
+  int spanOf(double pixels) const {
+    return qMax(1, int(std::ceil(pixels / m_cellSize)));
+  }
+
+  QVariant toPixels(const std::optional<QPoint> &cell) const {
+    if (!cell)
+      return {};
+    return QPointF(cell->x() * m_cellSize, cell->y() * m_cellSize);
+  }
+
+  void placeOnGrid(int index) {
+    if (m_cellSize <= 0)
+      return;
+    const Tile &t = m_tiles[index];
+    const QSize span = cellSpan(t.size);
+    m_grid.place(index, {qRound(t.modelX / m_cellSize), qRound(t.modelY / m_cellSize),
+                         span.width(), span.height()});
+  }
+
+  void rebuildGrid() {
+    m_grid.clear();
+    for (int i = 0; i < m_tiles.count(); ++i)
+      placeOnGrid(i);
+  }
+
+  static QString storePath() {
+    return QStandardPaths::writableLocation(
+      QStandardPaths::AppConfigLocation)
+    + "/launcher_tiles.bin";
+  }
 
-  QString jsonPath() const {
+  // Before the binary store; migrated once
+  static QString jsonPath() {
     return QStandardPaths::writableLocation(
       QStandardPaths::AppConfigLocation)
     + "/launcher_tiles.json";
@@ -1354,6 +1716,185 @@ private:
 };
 
 
+// ----------------------------
+// TileView
+// ----------------------------
+// The tiles of TileModel that intersect the visible part of the tile
+// surface (plus a margin on each side), as the model of the tile
+// Repeater. Rows are delegate slots: when a tile scrolls out and another
+// scrolls in, its slot is handed to the new tile with a dataChanged(), so
+// the delegate (transforms, images, live tile loader) is reused instead
+// of destroyed and created again. Slots are only added or removed when
+// the number of visible tiles changes.
+//
+// The TileIndexRole is the row in TileModel; QML passes it, not the slot
+// row, to tileModel's invokables.
+class TileView : public QAbstractListModel {
+  Q_OBJECT
+public:
+  enum Roles { TileIndexRole = TileModel::QmlGenerationRole + 1 };
+
+  // Margin on each side, in viewport widths; tiles are let go only once
+  // they are twice as far out, so scrolling back and forth does not churn
+  static constexpr double Margin = 0.5;
+
+  explicit TileView(TileModel *tiles, QObject *parent = nullptr)
+  : QAbstractListModel(parent), m_tiles(tiles) {
+    connect(tiles, &TileModel::geometryChanged, this, &TileView::refresh);
+    connect(tiles, &QAbstractItemModel::rowsInserted, this, &TileView::refresh);
+    connect(tiles, &QAbstractItemModel::rowsRemoved, this, &TileView::tilesRemoved);
+    connect(tiles, &QAbstractItemModel::modelReset, this, &TileView::resetSlots);
+    connect(tiles, &QAbstractItemModel::dataChanged, this,
+            [this](const QModelIndex &first, const QModelIndex &last, const QList<int> &roles) {
+              for (int slot = 0; slot < m_slots.count(); ++slot) {
+                if (m_slots[slot] >= first.row() && m_slots[slot] <= last.row())
+                  emit dataChanged(index(slot), index(slot), roles);
+              }
+              // Moved or resized tiles may enter or leave the viewport
+              if (roles.isEmpty() || roles.contains(TileModel::ModelXRole)
+                  || roles.contains(TileModel::SizeRole))
+                refresh();
+            });
+    refresh();
+  }
+
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override {
+    Q_UNUSED(parent);
+    return m_slots.count();
+  }
+
+  QVariant data(const QModelIndex &index, int role) const override {
+    if (!index.isValid() || index.row() >= m_slots.count())
+      return {};
+    const int tile = m_slots[index.row()];
+    if (role == TileIndexRole)
+      return tile;
+    return m_tiles->data(m_tiles->index(tile), role);
+  }
+
+  QHash<int, QByteArray> roleNames() const override {
+    QHash<int, QByteArray> roles = m_tiles->roleNames();
+    roles.insert(TileIndexRole, "tileIndex");
+    return roles;
+  }
+
+  // QML: contentX and width of the tile Flickable
+  Q_INVOKABLE void setViewport(double x, double width) {
+    if (qFuzzyCompare(x + 1, m_viewX + 1) && qFuzzyCompare(width, m_viewWidth))
+      return;
+    m_viewX = x;
+    m_viewWidth = width;
+    refresh();
+  }
+
+  // Slot (Repeater index) showing `tile`, or -1 while it is off screen
+  Q_INVOKABLE int slotOf(int tile) const {
+    return m_slotOf.value(tile, -1);
+  }
+
+private:
+  TileModel *m_tiles;
+  QList<int> m_slots;         // slot -> TileModel row
+  QHash<int, int> m_slotOf;   // TileModel row -> slot
+  double m_viewX = 0;
+  double m_viewWidth = 0;
+
+  void refresh() {
+    // Until the viewport is known, show everything
+    const double margin = m_viewWidth * Margin;
+    const double from = m_viewWidth > 0 ? m_viewX - margin : -1e9;
+    const double to = m_viewWidth > 0 ? m_viewX + m_viewWidth + margin : 1e9;
+
+    QList<int> wanted = m_tiles->tilesBetween(from, to);
+    QSet<int> wantedSet(wanted.cbegin(), wanted.cend());
+
+    // Tiles already showing stay until they are past the outer margin
+    for (int tile : std::as_const(m_slots)) {
+      if (wantedSet.contains(tile))
+        continue;
+      const QRectF rect = m_tiles->tileRect(tile);
+      if (rect.left() < to + margin && rect.right() > from - margin)
+        wantedSet.insert(tile);
+    }
+
+    // Tiles that need a slot, and slots that are free to take one
+    QList<int> incoming;
+    for (int tile : wanted) {
+      if (!m_slotOf.contains(tile))
+        incoming << tile;
+    }
+    QList<int> freeSlots;
+    for (int slot = 0; slot < m_slots.count(); ++slot) {
+      if (!wantedSet.contains(m_slots[slot]))
+        freeSlots << slot;
+    }
+
+    // Recycle
+    while (!incoming.isEmpty() && !freeSlots.isEmpty()) {
+      const int slot = freeSlots.takeFirst();
+      m_slotOf.remove(m_slots[slot]);
+      m_slots[slot] = incoming.takeFirst();
+      m_slotOf.insert(m_slots[slot], slot);
+      emit dataChanged(index(slot), index(slot));
+    }
+
+    if (!incoming.isEmpty()) {
+      beginInsertRows(QModelIndex(), m_slots.count(), m_slots.count() + incoming.count() - 1);
+      for (int tile : incoming) {
+        m_slotOf.insert(tile, m_slots.count());
+        m_slots << tile;
+      }
+      endInsertRows();
+    }
+
+    // Highest first, so the remaining free rows keep their numbers
+    for (auto it = freeSlots.crbegin(); it != freeSlots.crend(); ++it)
+      removeSlot(*it);
+  }
+
+  void removeSlot(int slot) {
+    beginRemoveRows(QModelIndex(), slot, slot);
+    m_slotOf.remove(m_slots.takeAt(slot));
+    for (int s = slot; s < m_slots.count(); ++s)
+      m_slotOf[m_slots[s]] = s;
+    endRemoveRows();
+  }
+
+  // Rows of TileModel went away: their slots go, and the delegates of
+  // later rows are told their new row instead of being created again
+  void tilesRemoved(const QModelIndex &parent, int first, int last) {
+    Q_UNUSED(parent);
+    for (int slot = m_slots.count() - 1; slot >= 0; --slot) {
+      if (m_slots[slot] >= first && m_slots[slot] <= last)
+        removeSlot(slot);
+    }
+
+    const int removed = last - first + 1;
+    QList<int> moved;
+    m_slotOf.clear();
+    for (int slot = 0; slot < m_slots.count(); ++slot) {
+      if (m_slots[slot] > last) {
+        m_slots[slot] -= removed;
+        moved << slot;
+      }
+      m_slotOf.insert(m_slots[slot], slot);
+    }
+    for (int slot : moved)
+      emit dataChanged(index(slot), index(slot), {TileIndexRole});
+
+    refresh();
+  }
+
+  // TileModel was reset; start over
+  void resetSlots() {
+    beginResetModel();
+    m_slots.clear();
+    m_slotOf.clear();
+    endResetModel();
+    refresh();
+  }
+};
+
 // ----------------------------
 // PowerControl
 // ----------------------------
@@ -1591,11 +2132,17 @@ public:
     }
   }
 
+  // Answers LAUNCH_STATS from `Win8Start --launch-stats`
+  void setStatsProvider(std::function<QByteArray()> provider) {
+    m_statsProvider = std::move(provider);
+  }
+
 signals:
   void activateRequested();
 
 private:
   QLocalServer *m_server;
+  std::function<QByteArray()> m_statsProvider;
 
   void handleConnection() {
     QLocalSocket *socket = m_server->nextPendingConnection();
@@ -1604,6 +2151,12 @@ private:
 
     socket->waitForReadyRead(100);
     QByteArray msg = socket->readAll();
+
+    if (msg == "LAUNCH_STATS" && m_statsProvider) {
+      socket->write(m_statsProvider());
+      socket->flush();
+      socket->waitForBytesWritten(1000);
+    }
     socket->disconnectFromServer();
 
     if (msg == "ACTIVATE")
@@ -1661,9 +2214,27 @@ int main(int argc, char *argv[]) {
   QLockFile lockFile(lockPath);
   lockFile.setStaleLockTime(0);
 
+  // `Win8Start --launch-stats`: print the running instance's
+  // launch-to-window latencies
+  const bool launchStats = argc > 1 && qstrcmp(argv[1], "--launch-stats") == 0;
+
   if (!lockFile.tryLock()) {
     QLocalSocket socket;
     socket.connectToServer("Win8StartInstance");
+    if (launchStats) {
+      if (!socket.waitForConnected(1000)) {
+        fputs("Win8Start is not running\n", stderr);
+        return 1;
+      }
+      socket.write("LAUNCH_STATS");
+      socket.flush();
+      QByteArray reply;
+      while (socket.waitForReadyRead(1000))
+        reply += socket.readAll();
+      reply += socket.readAll();
+      fwrite(reply.constData(), 1, size_t(reply.size()), stdout);
+      return 0;
+    }
     if (socket.waitForConnected(100)) {
       socket.write("ACTIVATE");
       socket.flush();
@@ -1672,6 +2243,12 @@ int main(int argc, char *argv[]) {
     return 0;
   }
 
+  if (launchStats) {
+    lockFile.unlock();
+    fputs("Win8Start is not running\n", stderr);
+    return 1;
+  }
+
   QSharedMemory win8LockCheck("Win8LockSingleton");
   if (win8LockCheck.attach()) {
     qWarning() << "⚠️ Win8Lock is running. Win8Start will not start.";
@@ -1769,6 +2346,16 @@ int main(int argc, char *argv[]) {
         }
       });
 
+  // --------------------------------------------------------
+  // Pinned tiles, read before the QML so the first frame has them
+  // --------------------------------------------------------
+  TileModel tileModel;
+  TileView tileView(&tileModel);
+  engine.rootContext()->setContextProperty("tileModel", &tileModel);
+  engine.rootContext()->setContextProperty("tileView", &tileView);
+  engine.rootContext()->setContextProperty("LiveTiles", tileModel.liveTiles());
+  engine.addImageProvider("livetile", tileModel.liveTiles()->createImageProvider());
+
   // --------------------------------------------------------
   // Load QML
   // --------------------------------------------------------
@@ -1854,15 +2441,17 @@ int main(int argc, char *argv[]) {
   // --------------------------------------------------------
   // Backend objects
   // --------------------------------------------------------
+  // Executables on PATH, for launches, TryExec= and run completion;
+  // indexed on the pool
+  PathIndex::instance().watch();
+
   AppLauncher launcher;
   AppModel appModel;
-  TileModel tileModel;
   PowerControl powerControl;
   Launcher launcherQml;
 
   engine.rootContext()->setContextProperty("AppLauncher", &launcher);
   engine.rootContext()->setContextProperty("appModel", &appModel);
-  engine.rootContext()->setContextProperty("tileModel", &tileModel);
   engine.rootContext()->setContextProperty("powerControl", &powerControl);
   engine.rootContext()->setContextProperty("Launcher", &launcherQml);
   engine.rootContext()->setContextProperty("WindowController",
@@ -1874,24 +2463,23 @@ int main(int argc, char *argv[]) {
   // Async application loading
   // --------------------------------------------------------
   QObject::connect(&launcher, &AppLauncher::applicationsLoaded,
-                   [&](const QVariantList &apps) {
-                     QList<AppInfo> appInfos;
-                     for (const QVariant &v : apps) {
-                       QVariantMap m = v.toMap();
-                       appInfos.append({
-                         m["name"].toString(),
-                         m["genericName"].toString(), 
-                         m["keywords"].toStringList(),
-                         m["command"].toString(),
-                         m["icon"].toString(),
-                         m["desktopFilePath"].toString(),
-                         m["categories"].toStringList()  ,
-                         m.value("terminal", false).toBool()
-                       });
-                       
-                     }
-                     appModel.setApps(appInfos);
+                   &appModel, &AppModel::setApps);
+
+  // Per-entry deltas from the inotify index
+  QObject::connect(&launcher, &AppLauncher::appAdded, &appModel, &AppModel::addApp);
+  QObject::connect(&launcher, &AppLauncher::appChanged, &appModel, &AppModel::updateApp);
+  QObject::connect(&launcher, &AppLauncher::appRemoved, &appModel, &AppModel::removeApp);
+
+  // Launch counts break ties in search and drive the "Most used" order
+  appModel.setLaunchLog(launcher.launchLog());
+  launcherQml.setSpawnClient(launcher.spawnClient());
+
+  // Launch-to-window latency, matched on the new toplevel's app_id
+  QObject::connect(&windowWatcher, &WindowWatcher::toplevelReady, &launcher,
+                   [&launcher](const QString &appId) {
+                     launcher.launchTracker()->windowShown(appId);
                    });
+  instance.setStatsProvider([&launcher]() { return launcher.launchTracker()->dump(); });
 
   QTimer::singleShot(0, [&launcher]() { launcher.listApplicationsAsync(); });
 
@@ -1903,8 +2491,11 @@ int main(int argc, char *argv[]) {
                          tileModel.reloadTileQml(i);
                      } else {
                        qDebug() << "🧹 Start hidden → releasing QML resources";
+                       launcher.cancelPrefetch();
                        clearQmlCaches(window);
                      }
+                     // Live tile logic only runs while it can be seen
+                     tileModel.setLogicPaused(!visible);
                    });
   
 
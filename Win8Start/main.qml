@@ -305,156 +305,54 @@ ApplicationWindow {
                 property int gridSize: tilearea.height/5
                 property int halfGrid: gridSize / 2
                 property int cols: Math.floor(width / halfGrid)
-                property int focusedIndex: -1
+                property int focusedIndex: -1           // row in tileModel
+                property bool tilesSettled: false       // first tiles created
                 
-                Component.onCompleted: {
-                    Qt.callLater(() => {
-                        const tolerance = Math.max(2, container.halfGrid * 0.15)
-                        // ~15% of grid or minimum 2px
-                        
-                        for (let i = 0; i < tileRepeater.count; ++i) {
-                            const t = tileRepeater.itemAt(i)
-                            if (!t) continue
-                                container.snapIfSlightlyOff(t, tolerance)
-                        }
-                    })
+                // The delegate showing tile `index`, or null while it is off screen
+                function tileItem(index) {
+                    const slot = tileView.slotOf(index)
+                    return slot < 0 ? null : tileRepeater.itemAt(slot)
                 }
                 
-                // Returns the next free position for a new tile (row-first, top-to-bottom, left-to-right)
-                function nextFreeTilePosition(tileW, tileH) {
-                    const grid = halfGrid
-                    const cols = Math.floor(contentWidth / grid)
-                    const rows = Math.floor(contentHeight / grid)
-                    
-                    // Build occupancy map
-                    const occupied = Array.from({ length: rows }, () => Array(cols).fill(false))
-                    
-                    for (let i = 0; i < tileRepeater.count; ++i) {
-                        const t = tileRepeater.itemAt(i)
-                        if (!t) continue
-                            if (t.launching || (t.dragArea && t.dragArea.dragging)) continue
-                                
-                                const c = Math.round(t.x / grid)
-                                const r = Math.round(t.y / grid)
-                                const tileCols = Math.ceil(t.width / grid)
-                                const tileRows = Math.ceil(t.height / grid)
-                                
-                                for (let rr = r; rr < r + tileRows && rr < rows; ++rr) {
-                                    for (let cc = c; cc < c + tileCols && cc < cols; ++cc) {
-                                        occupied[rr][cc] = true
-                                    }
-                                }
-                    }
-                    
-                    const tileCols = Math.ceil(tileW / grid)
-                    const tileRows = Math.ceil(tileH / grid)
-                    
-                    // Iterate columns first, then rows (fill Y first, then X)
-                    for (let c = 0; c <= cols - tileCols; ++c) {
-                        for (let r = 0; r <= rows - tileRows; ++r) {
-                            let free = true
-                            for (let rr = 0; rr < tileRows && free; ++rr) {
-                                for (let cc = 0; cc < tileCols && free; ++cc) {
-                                    if (occupied[r + rr][c + cc]) free = false
-                                }
-                            }
-                            if (free) return Qt.point(c * grid, r * grid)
-                        }
-                    }
-                    
-                    // No space available
-                    return null
-                }
+                // Only the tiles around the visible range get delegates
+                onContentXChanged: tileView.setViewport(contentX, width)
+                onWidthChanged: tileView.setViewport(contentX, width)
                 
+                // Warm the focused tile's app in the page cache
+                onFocusedIndexChanged: {
+                    const t = tileItem(focusedIndex)
+                    if (t && t.command.length > 0)
+                        AppLauncher.prefetchApp(t.command)
+                    else
+                        AppLauncher.cancelPrefetch()
+                }
                 
-                function nearestFreeSnap(x, y, tileWidth, tileHeight, excludeIndex) {
-                    const grid = halfGrid
-                    
-                    // Tile size in grid units
-                    const tileCols = Math.ceil(tileWidth / grid)
-                    const tileRows = Math.ceil(tileHeight / grid)
-                    
-                    // Snap requested position to grid
-                    const baseCol = Math.round(x / grid)
-                    const baseRow = Math.round(y / grid)
-                    
-                    // Build occupancy map from existing items
-                    const colsCount = Math.floor(contentWidth / grid)
-                    const rowsCount = Math.floor(contentHeight / grid)
-                    const occupied = Array.from({ length: rowsCount }, () => Array(colsCount).fill(false))
-                    
-                    for (let i = 0; i < tileRepeater.count; ++i) {
-                        if (i === excludeIndex) continue
-                            const t = tileRepeater.itemAt(i)
-                            if (!t) continue
-                                if (t.launching || (t.dragArea && t.dragArea.dragging)) continue
-                                    
-                                    const tCol = Math.round(t.x / grid)
-                                    const tRow = Math.round(t.y / grid)
-                                    const tCols = Math.ceil(t.width / grid)
-                                    const tRows = Math.ceil(t.height / grid)
-                                    
-                                    for (let r = tRow; r < tRow + tRows && r < rowsCount; ++r) {
-                                        for (let c = tCol; c < tCol + tCols && c < colsCount; ++c) {
-                                            occupied[r][c] = true
-                                        }
-                                    }
-                    }
-                    
-                    // Check if a tile fits at a specific grid cell
-                    function fitsAt(col, row) {
-                        if (col < 0 || row < 0) return false
-                            if (col + tileCols > colsCount) return false
-                                if (row + tileRows > rowsCount) return false
-                                    
-                                    for (let r = row; r < row + tileRows; ++r) {
-                                        for (let c = col; c < col + tileCols; ++c) {
-                                            if (occupied[r][c]) return false
-                                        }
-                                    }
-                                    return true
-                    }
-                    
-                    // If base position fits, accept immediately
-                    if (fitsAt(baseCol, baseRow)) {
-                        return Qt.point(baseCol * grid, baseRow * grid)
-                    }
-                    
-                    // Otherwise, search nearby positions
-                    const maxSteps = 4
-                    let candidates = []
-                    
-                    for (let dr = -maxSteps; dr <= maxSteps; ++dr) {
-                        for (let dc = -maxSteps; dc <= maxSteps; ++dc) {
-                            if (dr === 0 && dc === 0) continue
-                                const nc = baseCol + dc
-                                const nr = baseRow + dr
-                                if (fitsAt(nc, nr)) {
-                                    candidates.push({
-                                        col: nc,
-                                        row: nr,
-                                        dist: Math.abs(dc) + Math.abs(dr)
-                                    })
-                                }
-                        }
-                    }
-                    
-                    candidates.sort((a, b) => a.dist - b.dist)
-                    
-                    if (candidates.length > 0) {
-                        const c = candidates[0]
-                        return Qt.point(c.col * grid, c.row * grid)
-                    }
-                    
-                    // ✅ No free space available
-                    return null
+                // Tile geometry lives in tileModel's occupancy grid
+                function updateTileGrid() {
+                    if (halfGrid > 0)
+                        tileModel.setGrid(halfGrid,
+                                          Math.floor(contentWidth / halfGrid),
+                                          Math.floor(contentHeight / halfGrid))
                 }
+                onHalfGridChanged: updateTileGrid()
+                onContentWidthChanged: updateTileGrid()
+                onContentHeightChanged: updateTileGrid()
                 
+                Component.onCompleted: {
+                    updateTileGrid()
+                    tileView.setViewport(contentX, width)
+                    Qt.callLater(() => {
+                        // ~15% of grid or minimum 2px
+                        tileModel.snapTiles(Math.max(2, container.halfGrid * 0.15))
+                        tilesSettled = true
+                    })
+                }
                 
                 // keeps the focused item in view when using keyboard navigation.
                 function ensureVisible(index) {
-                    let t = tileRepeater.itemAt(index)
-                    if (!t) return
+                    // From the model: the tile may not have a delegate yet
+                    const t = tileModel.tileRect(index)
+                    if (t.width <= 0) return
                         if (t.x < contentX)
                             contentX = t.x
                             else if (t.x + t.width > contentX + width)
@@ -463,80 +361,14 @@ ApplicationWindow {
                 
                 
                 Keys.onPressed: (event) => {
-                    if (tileRepeater.count === 0)
+                    if (tileModel.rowCount() === 0)
                         return
                         if (focusedIndex < 0)
                             focusedIndex = 0
-                            let currentItem = tileRepeater.itemAt(focusedIndex)
-                            if (!currentItem)
-                                return
-                                
-                                function distance(a, b) {
-                                    return Math.hypot(a.x - b.x, a.y - b.y);
-                                }
+                            // Null while the focused tile is scrolled away;
+                            // navigation only needs the model
+                            let currentItem = tileItem(focusedIndex)
                                 
-                                function findNext(dx, dy) {
-                                    let best = -1;
-                                    let bestDist = Infinity;
-                                    let fallback = -1;
-                                    let fallbackDist = Infinity;
-                                    
-                                    const cx = currentItem.x + currentItem.width / 2;
-                                    const cy = currentItem.y + currentItem.height / 2;
-                                    const cLeft = currentItem.x;
-                                    const cRight = currentItem.x + currentItem.width;
-                                    const cTop = currentItem.y;
-                                    const cBottom = currentItem.y + currentItem.height;
-                                    
-                                    for (let i = 0; i < tileRepeater.count; ++i) {
-                                        if (i === focusedIndex)
-                                            continue;
-                                        
-                                        let item = tileRepeater.itemAt(i);
-                                        if (!item)
-                                            continue;
-                                        
-                                        const ix = item.x + item.width / 2;
-                                        const iy = item.y + item.height / 2;
-                                        const iLeft = item.x;
-                                        const iRight = item.x + item.width;
-                                        const iTop = item.y;
-                                        const iBottom = item.y + item.height;
-                                        
-                                        const vx = ix - cx;
-                                        const vy = iy - cy;
-                                        
-                                        // Direction filter
-                                        if ((dx !== 0 && Math.sign(vx) !== dx) ||
-                                            (dy !== 0 && Math.sign(vy) !== dy))
-                                            continue;
-                                        
-                                        // Axis-alignment check using edges
-                                        let aligned = false;
-                                        if (dx !== 0) {
-                                            // LEFT/RIGHT: check if vertical spans overlap
-                                            aligned = !(cBottom < iTop || cTop > iBottom);
-                                        } else {
-                                            // UP/DOWN: check if horizontal spans overlap
-                                            aligned = !(cRight < iLeft || cLeft > iRight);
-                                        }
-                                        
-                                        const dist = distance({x: ix, y: iy}, {x: cx, y: cy});
-                                        
-                                        if (aligned) {
-                                            if (dist < bestDist) {
-                                                bestDist = dist;
-                                                best = i;
-                                            }
-                                        } else {
-                                            if (dist < fallbackDist) {
-                                                fallbackDist = dist;
-                                                fallback = i;
-                                            }
-                                        }
-                                    }
-                                    return best !== -1 ? best : fallback;
-                                }
                                 let next = -1
                                 
                                 // Alphanumeric key handling: focus searchField
@@ -560,16 +392,16 @@ ApplicationWindow {
                                 
                                 switch (event.key) {
                                     case Qt.Key_Left:
-                                        next = findNext(-1, 0)
+                                        next = tileModel.neighbour(focusedIndex, -1, 0)
                                         break
                                     case Qt.Key_Right:
-                                        next = findNext(1, 0)
+                                        next = tileModel.neighbour(focusedIndex, 1, 0)
                                         break
                                     case Qt.Key_Up:
-                                        next = findNext(0, -1)
+                                        next = tileModel.neighbour(focusedIndex, 0, -1)
                                         break
                                     case Qt.Key_Down:
-                                        next = findNext(0, 1)
+                                        next = tileModel.neighbour(focusedIndex, 0, 1)
                                         break
                                     case Qt.Key_A:
                                         // Check for Ctrl modifier
@@ -588,7 +420,10 @@ ApplicationWindow {
                                     case Qt.Key_Return:
                                     case Qt.Key_Enter:
                                     case Qt.Key_Space:
-                                        currentItem.launch()
+                                        if (currentItem)
+                                            currentItem.launch()
+                                        else
+                                            ensureVisible(focusedIndex)
                                         
                                         event.accepted = true
                                         return
@@ -662,7 +497,7 @@ ApplicationWindow {
                         const hintX = mouseX - tileW / 2
                         const hintY = mouseY - tileH / 2
                         
-                        const p = container.nearestFreeSnap(hintX, hintY, tileW, tileH, -1)
+                        const p = tileModel.nearestFreeSlot(hintX, hintY, tileW, tileH, -1)
                         
                         if (p) {
                             snapGhost.visible = true
@@ -691,7 +526,7 @@ ApplicationWindow {
                                     const hintX = drop.x - tileW / 2
                                     const hintY = drop.y - tileH / 2
                                     
-                                    const p = container.nearestFreeSnap(hintX, hintY, tileW, tileH, -1)
+                                    const p = tileModel.nearestFreeSlot(hintX, hintY, tileW, tileH, -1)
                                     if (p) {
                                         tileModel.addTileFromDesktopFile(localPath, p.x, p.y)
                                     }
@@ -717,7 +552,7 @@ ApplicationWindow {
                 
                 Repeater {
                     id: tileRepeater
-                    model: tileModel
+                    model: tileView
                     
                     Rectangle {
                         id: tile
@@ -725,12 +560,13 @@ ApplicationWindow {
                         
                         // --- Size handling ---
                         
-                        required property int index
+                        required property int tileIndex       // row in tileModel
                         required property real modelX
                         required property real modelY
                         required property string name
                         required property string icon
                         required property string command
+                        required property string desktopFile
                         required property string size
                         required property bool terminal
                         required property string tileColor
@@ -769,7 +605,7 @@ ApplicationWindow {
                         : Win8Colors.Tile
                         
                         property color baseColor: dragArea.dragging
-                        || container.focusedIndex === index
+                        || container.focusedIndex === tileIndex
                         || hovered
                         ? Qt.lighter(effectiveColor, 1.3)
                         : effectiveColor
@@ -788,9 +624,9 @@ ApplicationWindow {
                             }
                         }
                         
-                        border.width: (!suppressBorder && (container.focusedIndex === index || hovered)) ? 1 : 0
+                        border.width: (!suppressBorder && (container.focusedIndex === tileIndex || hovered)) ? 1 : 0
                         
-                        border.color: container.focusedIndex === index || hovered
+                        border.color: container.focusedIndex === tileIndex || hovered
                         ? "#949494"
                         : Qt.rgba(1,1,1,0.2)
                         
@@ -803,7 +639,7 @@ ApplicationWindow {
                             title: "Choose Tile Color"
                             
                             onAccepted: {
-                                tileModel.setTileColor(tile.index, selectedColor)
+                                tileModel.setTileColor(tile.tileIndex, selectedColor)
                                 WindowController.show()
                             }
                             onRejected: {
@@ -818,17 +654,19 @@ ApplicationWindow {
                                 
                                 tile.launching = true
                                 container.anyTileLaunching = true
-                                AppLauncher.launchApp(tile.command, tile.terminal)
+                                AppLauncher.launchApp(tile.command, tile.terminal, tile.desktopFile)
                         }
                         
                         function updateSnapGhost() {
-                            const p = container.nearestFreeSnap(
+                            const p = tileModel.nearestFreeSlot(
                                 tile.x,
                                 tile.y,
                                 tile.width,
                                 tile.height,
-                                tile.index
+                                tile.tileIndex
                             )
+                            if (!p)
+                                return
                             
                             snapGhost.x = p.x
                             snapGhost.y = p.y
@@ -871,6 +709,13 @@ ApplicationWindow {
                             // Use file:/// prefix for absolute filesystem paths
                             source: active ? ("file:///" + tileQml) : ""
                             
+                            // Tiles that declare `property var liveTile` get the
+                            // data their logic publishes on the LiveTiles bus
+                            onLoaded: {
+                                if ("liveTile" in item)
+                                    item.liveTile = LiveTiles.channel(tileQml)
+                            }
+                            
                             onStatusChanged: {
                                 if (status === Loader.Ready) {
                                     console.log("✅ Tile loaded successfully:", tileQml)
@@ -1167,10 +1012,12 @@ ApplicationWindow {
                             property bool dragging: false
                             onEntered: {
                                 tile.hovered = true
-                                container.focusedIndex = tile.index
+                                container.focusedIndex = tile.tileIndex
+                                AppLauncher.prefetchApp(tile.command)
                             }
                             onExited: {
                                 tile.hovered = false
+                                AppLauncher.cancelPrefetch()
                             }
                             
                             Timer {
@@ -1212,7 +1059,7 @@ ApplicationWindow {
                                         Math.min(snapGhost.y, container.contentHeight - tile.height)
                                     )
                                     
-                                    tileModel.updateTilePosition(tile.index, tile.x, tile.y)
+                                    tileModel.updateTilePosition(tile.tileIndex, tile.x, tile.y)
                                 }
                                 
                                 snapGhost.visible = false
@@ -1259,7 +1106,7 @@ ApplicationWindow {
                             tile.x = snappedX
                             tile.y = snappedY
                             
-                            tileModel.updateTilePosition(tile.index, tile.x, tile.y)
+                            tileModel.updateTilePosition(tile.tileIndex, tile.x, tile.y)
                         }
                         
                         //-----------------------------------------------------------
@@ -1268,10 +1115,10 @@ ApplicationWindow {
                         Menu {
                             id: contextMenu
                             
-                            MenuItem { text: "Small";   onTriggered: tileModel.resizeTile(tile.index, "small") }
-                            MenuItem { text: "Medium";  onTriggered: tileModel.resizeTile(tile.index, "medium") }
-                            MenuItem { text: "Large";   onTriggered: tileModel.resizeTile(tile.index, "large") }
-                            MenuItem { text: "XLarge";  onTriggered: tileModel.resizeTile(tile.index, "xlarge") }
+                            MenuItem { text: "Small";   onTriggered: tileModel.resizeTile(tile.tileIndex, "small") }
+                            MenuItem { text: "Medium";  onTriggered: tileModel.resizeTile(tile.tileIndex, "medium") }
+                            MenuItem { text: "Large";   onTriggered: tileModel.resizeTile(tile.tileIndex, "large") }
+                            MenuItem { text: "XLarge";  onTriggered: tileModel.resizeTile(tile.tileIndex, "xlarge") }
                             
                             MenuSeparator {}
                             
@@ -1286,19 +1133,23 @@ ApplicationWindow {
                             MenuItem {
                                 text: "Reset Color"
                                 enabled: tileColor && tileColor.length > 0
-                                onTriggered: tileModel.resetTileColor(tile.index)
+                                onTriggered: tileModel.resetTileColor(tile.tileIndex)
                             }
                             MenuSeparator {}
                             
+                            MenuItem { text: "Compact Group"; onTriggered: tileModel.compactGroup(tile.tileIndex) }
+                            
+                            MenuSeparator {}
+                            
                             MenuItem {
                                 text: qmlEnabled ? "Disable Live Tile" : "Enable Live Tile"
-                                onTriggered: tileModel.setTileQmlEnabled(tile.index, !qmlEnabled)
+                                onTriggered: tileModel.setTileQmlEnabled(tile.tileIndex, !qmlEnabled)
                             }
                             
                             
                             MenuSeparator {}
                             
-                            MenuItem { text: "Remove"; onTriggered: tileModel.removeTile(tile.index) }
+                            MenuItem { text: "Remove"; onTriggered: tileModel.removeTile(tile.tileIndex) }
                         }
                         
                         
@@ -1379,19 +1230,48 @@ ApplicationWindow {
                             
                         }
                         
-                        Component.onCompleted: {
+                        function attachTileQml() {
                             if (tileQml && tileQml.length > 0) {
-                                tileModel.setTileQml(index, tileQml)
+                                tileModel.setTileQml(tileIndex, tileQml)
                             } else if (name && name.length > 0) {
-                                tileModel.setTileQml(index, name)
+                                tileModel.setTileQml(tileIndex, name)
                             }
+                        }
+                        
+                        Component.onCompleted: {
+                            attachTileQml()
                             
-                            if (!appeared) {
+                            // Tiles scrolled into view later just appear
+                            if (!appeared && !container.tilesSettled) {
                                 appeared = true
                                 appearAnim.start()
+                            } else {
+                                appeared = true
+                                opacity = 1
                             }
                         }
                         
+                        // Slot recycled for another tile: drop the previous
+                        // tile's position overrides and hover state
+                        onTileIndexChanged: {
+                            x = Qt.binding(() => modelX)
+                            y = Qt.binding(() => modelY)
+                            hovered = false
+                            dragArea.dragging = false
+                            if (launching) {
+                                // Recycled mid-launch: the new tile starts at rest
+                                launching = false
+                                container.anyTileLaunching = false
+                                zoomScale.xScale = 1
+                                zoomScale.yScale = 1
+                                flipRotation.angle = 0
+                                zoomiconScale.xScale = 1
+                                zoomiconScale.yScale = 1
+                                flipiconRotation.angle = 0
+                            }
+                            attachTileQml()
+                        }
+                        
                         
                         
                         Connections {
@@ -1511,13 +1391,42 @@ ApplicationWindow {
                     background: null
                     placeholderTextColor: "#888888"
                     font.pointSize: 16
+                    
+                    // "> command" runs a command; Tab completes it from the PATH index
+                    readonly property bool runMode: text.startsWith(">")
+                    readonly property string runCommand: text.substring(1).trim()
+                    property string completion: ""
+                    
                     onTextChanged: {
+                        if (runMode) {
+                            var word = runCommand
+                            var matches = word.length > 0 && word.indexOf(" ") < 0
+                            ? AppLauncher.completeCommand(word, 1) : []
+                            completion = matches.length > 0 ? matches[0].substring(word.length) : ""
+                            return
+                        }
+                        completion = ""
                         appModel.search(text)
                         appGridView.currentIndex = 0   // ⭐ reset selection
                         categoryFilter.currentIndex = 0
                     }
                     
+                    // Completion shown after the typed text
+                    Text {
+                        visible: searchField.completion.length > 0
+                        x: searchField.leftPadding + searchField.contentWidth
+                        anchors.verticalCenter: parent.verticalCenter
+                        text: searchField.completion
+                        color: "#888888"
+                        font: searchField.font
+                    }
+                    
                     Keys.onTabPressed: {
+                        if (runMode && completion.length > 0) {
+                            text += completion
+                            cursorPosition = text.length
+                            return
+                        }
                         appGridView.forceActiveFocus()
                     }
                     Keys.onPressed: function(event) {
@@ -1531,6 +1440,15 @@ ApplicationWindow {
                                 break
                             case Qt.Key_Return:
                             case Qt.Key_Enter:
+                                if (runMode) {
+                                    if (runCommand.length > 0) {
+                                        AppLauncher.launchApp(runCommand, false)
+                                        text = ""
+                                        WindowController.hide()
+                                    }
+                                    event.accepted = true
+                                    break
+                                }
                                 if (appGridView.count > 0) {
                                     // Launch the first app (currentIndex = 0)
                                     appGridView.currentIndex = 0
@@ -1588,6 +1506,34 @@ ApplicationWindow {
                         appGridView.focus = true
             }
         }
+
+        ComboBox {
+            id: sortOrder
+            anchors.top: apps.top
+            anchors.left: categoryFilter.right
+            anchors.topMargin: 10
+            anchors.leftMargin: 40
+            width: 300
+            height: apps.height
+            font.pixelSize: 40
+            font.weight: Font.Thin
+            model: ["By name", "Most used"]
+            currentIndex: 0
+
+            background: Rectangle {
+                color: "transparent"
+                border.color: "transparent"
+            }
+
+            Keys.onTabPressed: {
+                appGridView.forceActiveFocus()
+            }
+
+            onCurrentIndexChanged: {
+                appModel.setMostUsedSort(currentIndex === 1)
+                appGridView.currentIndex = 0
+            }
+        }
         
         Item {
             anchors.top: apps.bottom
@@ -1623,6 +1569,12 @@ ApplicationWindow {
                 // index of currently launching delegate
                 property int launchingIndex: -1
                 
+                // Warm the current app in the page cache while All Apps is open
+                onCurrentItemChanged: {
+                    if (allapparea.y === 0 && currentItem)
+                        AppLauncher.prefetchApp(currentItem.command)
+                }
+                
                 ScrollBar.horizontal: ScrollBar { policy: ScrollBar.AsNeeded }
                 
                 function iconName(fullPathOrName) {
@@ -1771,7 +1723,7 @@ ApplicationWindow {
                                     break
                                 case Qt.Key_F5:
                                     if (AppLauncher) {
-                                        AppLauncher.refreshApplications()
+                                        AppLauncher.rescanApplications()
                                         event.accepted = true
                                     }
                                     break
@@ -1826,7 +1778,7 @@ ApplicationWindow {
                     function launch() {
                         launching = true
                         apptext.opacity = 0
-                        AppLauncher.launchApp(command, terminal)
+                        AppLauncher.launchApp(command, terminal, desktopFilePath)
                         launchAnimAllapp.start()
                     }
                     
@@ -1925,7 +1877,7 @@ ApplicationWindow {
                                 
                                 onTriggered: {
                                     appGridView.launchingIndex = apptilecol.index
-                                    AppLauncher.launchApp(apptilecol.command)
+                                    AppLauncher.launchApp(apptilecol.command, apptilecol.terminal, apptilecol.desktopFilePath)
                                     launchAnimAllapp.start()
                                 }
                             }
@@ -1944,7 +1896,7 @@ ApplicationWindow {
                                     // Determine default tile size in pixels
                                     var tileW = container.halfGrid * 2 - 5    // medium tile width
                                     var tileH = tileW                          // medium tile height
-                                    var pos = container.nextFreeTilePosition(tileW, tileH)
+                                    var pos = tileModel.nextFreeSlot(tileW, tileH)
                                     
                                     if (pos) {
                                         tileModel.addTileFromAppModel(appData, pos.x, pos.y)
@@ -1969,7 +1921,7 @@ ApplicationWindow {
                                     onTriggered: {
                                         apptilecol.launching = true
                                         appGridView.launchingIndex = index
-                                        AppLauncher.launchApp(command, terminal)
+                                        AppLauncher.launchApp(command, terminal, apptilecol.desktopFilePath)
                                         apptext.opacity = 0
                                         launchAnimAllapp.start()
                                     }
@@ -1985,7 +1937,9 @@ ApplicationWindow {
                             
                             onEntered: {
                                 appGridView.currentIndex = apptilecol.index
+                                AppLauncher.prefetchApp(apptilecol.command)
                             }
+                            onExited: AppLauncher.cancelPrefetch()
                             
                             property bool dragStarted: false
                             property bool dragAllowed: false
@@ -2059,7 +2013,7 @@ ApplicationWindow {
                                         appGridView.launchingIndex = apptilecol.index
                                         apptilecol.launching = true
                                         apptext.opacity = 0
-                                        AppLauncher.launchApp(apptilecol.command, apptilecol.terminal)
+                                        AppLauncher.launchApp(apptilecol.command, apptilecol.terminal, apptilecol.desktopFilePath)
                                         launchAnimAllapp.start()
                                     }
                                     
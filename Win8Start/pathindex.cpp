@@ -0,0 +1,196 @@
+#include "pathindex.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QFutureWatcher>
+#include <QTimer>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+PathIndex &PathIndex::instance() {
+    static PathIndex index;
+    return index;
+}
+
+PathIndex::PathIndex() {
+    // The first lookup may come from a pool thread; the watches and the
+    // debounce timer belong to the GUI thread
+    if (QCoreApplication::instance())
+        moveToThread(QCoreApplication::instance()->thread());
+
+    // Off the startup path: a stat per file of every PATH directory.
+    // A rescan that finishes first wins.
+    m_seed = QtConcurrent::run([this]() {
+        Table table = scan();
+        QWriteLocker locker(&m_lock);
+        if (!m_seeded) {
+            m_table = std::move(table);
+            m_seeded = true;
+        }
+    });
+}
+
+PathIndex::~PathIndex() {
+    m_seed.waitForFinished();
+}
+
+// -----------------------------
+// Scan
+// -----------------------------
+QStringList PathIndex::pathDirs() {
+    QString path = qEnvironmentVariable("PATH");
+    if (path.isEmpty())
+        path = "/usr/local/bin:/usr/bin:/bin";
+
+    QStringList dirs;
+    for (const QString &dir : path.split(':', Qt::SkipEmptyParts))
+        dirs << QDir::cleanPath(dir);
+    dirs.removeDuplicates();
+    return dirs;
+}
+
+PathIndex::Table PathIndex::scan() {
+    Table t;
+    t.dirs = pathDirs();
+
+    QCryptographicHash md5(QCryptographicHash::Md5);
+    for (const QString &dir : t.dirs) {
+        md5.addData(dir.toUtf8());
+        md5.addData(QByteArray::number(QFileInfo(dir).lastModified().toMSecsSinceEpoch()));
+
+        QDirIterator it(dir, QDir::Files | QDir::Executable);
+        while (it.hasNext()) {
+            const QString path = it.next();
+            t.paths.insert(path);
+            const QString name = it.fileName();
+            if (!t.byName.contains(name))
+                t.byName.insert(name, path);
+        }
+    }
+
+    t.names = t.byName.keys();
+    std::sort(t.names.begin(), t.names.end());
+    t.stamp = md5.result().toHex();
+    return t;
+}
+
+// -----------------------------
+// Lookups
+// -----------------------------
+QString PathIndex::find(const QString &program) const {
+    if (program.isEmpty())
+        return QString();
+
+    const int slash = program.lastIndexOf('/');
+    QReadLocker locker(&m_lock);
+
+    if (!m_seeded) {
+        locker.unlock();
+        return findOnDisk(program);
+    }
+
+    if (slash < 0)
+        return m_table.byName.value(program);
+
+    // Absolute paths into PATH directories are answered from the table
+    const QString dir = QDir::cleanPath(program.left(slash));
+    if (program.startsWith('/') && m_table.dirs.contains(dir))
+        return m_table.paths.contains(dir + "/" + program.mid(slash + 1)) ? program : QString();
+
+    locker.unlock();
+    const QFileInfo fi(program);
+    return fi.isFile() && fi.isExecutable() ? fi.absoluteFilePath() : QString();
+}
+
+// Before the first table: the same answer, one stat per PATH directory
+QString PathIndex::findOnDisk(const QString &program) {
+    QStringList candidates{program};
+    if (!program.contains('/')) {
+        candidates.clear();
+        for (const QString &dir : pathDirs())
+            candidates << dir + "/" + program;
+    }
+
+    for (const QString &path : std::as_const(candidates)) {
+        const QFileInfo fi(path);
+        if (fi.isFile() && fi.isExecutable())
+            return fi.absoluteFilePath();
+    }
+    return QString();
+}
+
+QStringList PathIndex::complete(const QString &prefix, int limit) const {
+    QStringList out;
+    if (prefix.isEmpty() || limit <= 0)
+        return out;
+
+    QReadLocker locker(&m_lock);
+    auto it = std::lower_bound(m_table.names.cbegin(), m_table.names.cend(), prefix);
+    for (; it != m_table.names.cend() && it->startsWith(prefix) && out.size() < limit; ++it)
+        out << *it;
+    return out;
+}
+
+// -----------------------------
+// Watches
+// -----------------------------
+// Package installs touch PATH directories in bursts; one rescan per burst
+void PathIndex::watch() {
+    if (m_watcher)
+        return;
+
+    m_debounce = new QTimer(this);
+    m_debounce->setSingleShot(true);
+    m_debounce->setInterval(500);
+    connect(m_debounce, &QTimer::timeout, this, &PathIndex::rescan);
+
+    m_watcher = new QFileSystemWatcher(this);
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged, m_debounce,
+            qOverload<>(&QTimer::start));
+
+    for (const QString &dir : pathDirs()) {
+        if (QFileInfo::exists(dir))
+            m_watcher->addPath(dir);
+    }
+}
+
+void PathIndex::rescan() {
+    if (m_scanning) {
+        m_debounce->start();
+        return;
+    }
+    m_scanning = true;
+
+    auto *watcher = new QFutureWatcher<Table>(this);
+    connect(watcher, &QFutureWatcher<Table>::finished, this, [this, watcher]() {
+        Table table = watcher->future().takeResult();
+        watcher->deleteLater();
+        m_scanning = false;
+
+        bool differs;
+        {
+            QWriteLocker locker(&m_lock);
+            differs = !m_seeded || table.stamp != m_table.stamp;
+            m_table = std::move(table);
+            m_seeded = true;
+        }
+
+        // Directories created after startup
+        for (const QString &dir : m_table.dirs) {
+            if (!m_watcher->directories().contains(dir) && QFileInfo::exists(dir))
+                m_watcher->addPath(dir);
+        }
+
+        if (differs) {
+            qDebug() << "🔎 PATH index updated:" << m_table.byName.size() << "executables";
+            emit changed();
+        }
+    });
+    watcher->setFuture(QtConcurrent::run(&PathIndex::scan));
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFuture>
+#include <QHash>
+#include <QObject>
+#include <QReadWriteLock>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+class QFileSystemWatcher;
+class QTimer;
+
+// ----------------------------
+// PathIndex
+// ----------------------------
+// In-memory table of the executables on $PATH, first directory first, as
+// the shell would pick them. Built off-thread on first use, then rebuilt
+// off-thread when a watched PATH directory changes, so launches, TryExec=
+// checks and command completion are hash and binary-search lookups
+// without a stat per PATH entry. Until the first table lands, find()
+// checks the disk and complete() has nothing.
+//
+// Safe to use from any thread; watch() belongs on the GUI thread.
+class PathIndex : public QObject {
+    Q_OBJECT
+public:
+    static PathIndex &instance();
+
+    // Absolute path of `program` (a bare name, or an absolute path inside
+    // a PATH directory), or an empty string when the index has no such
+    // executable. Other paths are checked on disk.
+    QString find(const QString &program) const;
+    bool contains(const QString &program) const { return !find(program).isEmpty(); }
+
+    // Executable names starting with `prefix`, sorted, at most `limit`
+    QStringList complete(const QString &prefix, int limit) const;
+
+    // Start the directory watches
+    void watch();
+
+signals:
+    void changed();
+
+private:
+    PathIndex();
+    ~PathIndex() override;
+
+    struct Table {
+        QStringList dirs;                   // PATH, deduplicated, in order
+        QHash<QString, QString> byName;     // name -> path of the first match
+        QSet<QString> paths;                // every indexed path, shadowed or not
+        QStringList names;                  // sorted, for completion
+        QByteArray stamp;
+    };
+
+    mutable QReadWriteLock m_lock;
+    Table m_table;
+    bool m_seeded = false;              // m_table holds a scan
+    QFuture<void> m_seed;
+    QFileSystemWatcher *m_watcher = nullptr;
+    QTimer *m_debounce = nullptr;
+    bool m_scanning = false;
+
+    static QStringList pathDirs();
+    static Table scan();
+    static QString findOnDisk(const QString &program);
+    void rescan();
+};
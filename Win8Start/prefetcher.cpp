@@ -0,0 +1,363 @@
+#include "prefetcher.h"
+#include "pathindex.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
+
+#include <algorithm>
+#include <vector>
+
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// -----------------------------
+// ELF dynamic section
+// -----------------------------
+namespace {
+
+constexpr qint64 ChunkBytes = 2 * 1024 * 1024;
+
+struct ElfDeps {
+    unsigned char elfClass = 0;
+    quint16 machine = 0;
+    QStringList needed;
+    QStringList rpath;        // DT_RPATH, only used without DT_RUNPATH
+    QStringList runpath;
+};
+
+bool readAt(int fd, void *buffer, size_t size, off_t offset) {
+    return pread(fd, buffer, size, offset) == ssize_t(size);
+}
+
+template <typename Ehdr, typename Phdr, typename Dyn>
+bool readDynamic(int fd, ElfDeps *deps) {
+    Ehdr eh;
+    if (!readAt(fd, &eh, sizeof(eh), 0))
+        return false;
+    if (eh.e_phentsize != sizeof(Phdr) || eh.e_phnum == 0 || eh.e_phnum > 512)
+        return false;
+    deps->machine = eh.e_machine;
+
+    std::vector<Phdr> ph(eh.e_phnum);
+    if (!readAt(fd, ph.data(), ph.size() * sizeof(Phdr), off_t(eh.e_phoff)))
+        return false;
+
+    const auto dynamic = std::find_if(ph.begin(), ph.end(),
+                                      [](const Phdr &p) { return p.p_type == PT_DYNAMIC; });
+    if (dynamic == ph.end())
+        return true;      // static
+
+    std::vector<Dyn> dyn(std::min<size_t>(dynamic->p_filesz / sizeof(Dyn), 4096));
+    if (!readAt(fd, dyn.data(), dyn.size() * sizeof(Dyn), off_t(dynamic->p_offset)))
+        return false;
+
+    quint64 strtab = 0, strsz = 0;
+    std::vector<quint64> needed, rpath, runpath;
+    for (const Dyn &d : dyn) {
+        if (d.d_tag == DT_NULL)
+            break;
+        switch (d.d_tag) {
+        case DT_NEEDED:  needed.push_back(d.d_un.d_val); break;
+        case DT_RPATH:   rpath.push_back(d.d_un.d_val); break;
+        case DT_RUNPATH: runpath.push_back(d.d_un.d_val); break;
+        case DT_STRTAB:  strtab = d.d_un.d_ptr; break;
+        case DT_STRSZ:   strsz = d.d_un.d_val; break;
+        default: break;
+        }
+    }
+    if (needed.empty())
+        return true;
+
+    // DT_STRTAB is an address; find it in the file through its segment
+    qint64 offset = -1;
+    for (const Phdr &p : ph) {
+        if (p.p_type == PT_LOAD && strtab >= p.p_vaddr && strtab < p.p_vaddr + p.p_filesz) {
+            offset = qint64(p.p_offset + (strtab - p.p_vaddr));
+            break;
+        }
+    }
+    if (offset < 0 || strsz == 0 || strsz > 16 * 1024 * 1024)
+        return false;
+
+    QByteArray strings(qsizetype(strsz), Qt::Uninitialized);
+    if (!readAt(fd, strings.data(), size_t(strsz), off_t(offset)))
+        return false;
+
+    // QByteArray keeps a terminating NUL past the end
+    const auto string = [&](quint64 at) {
+        return at < strsz ? QString::fromLocal8Bit(strings.constData() + at) : QString();
+    };
+    for (quint64 at : needed)
+        deps->needed << string(at);
+    for (quint64 at : rpath)
+        deps->rpath << string(at).split(':', Qt::SkipEmptyParts);
+    for (quint64 at : runpath)
+        deps->runpath << string(at).split(':', Qt::SkipEmptyParts);
+    return true;
+}
+
+// False for anything that is not a native-endian ELF file
+bool readElf(const QString &path, ElfDeps *deps) {
+    const int fd = open(QFile::encodeName(path).constData(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    unsigned char ident[EI_NIDENT];
+    bool ok = readAt(fd, ident, sizeof(ident), 0)
+              && std::equal(ident, ident + SELFMAG, ELFMAG)
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+              && ident[EI_DATA] == ELFDATA2LSB;
+#else
+              && ident[EI_DATA] == ELFDATA2MSB;
+#endif
+    if (ok) {
+        deps->elfClass = ident[EI_CLASS];
+        if (deps->elfClass == ELFCLASS64)
+            ok = readDynamic<Elf64_Ehdr, Elf64_Phdr, Elf64_Dyn>(fd, deps);
+        else if (deps->elfClass == ELFCLASS32)
+            ok = readDynamic<Elf32_Ehdr, Elf32_Phdr, Elf32_Dyn>(fd, deps);
+        else
+            ok = false;
+    }
+    close(fd);
+    return ok;
+}
+
+// -----------------------------
+// Library search
+// -----------------------------
+void readLdConf(const QString &path, QStringList *dirs, int depth) {
+    QFile f(path);
+    if (depth > 4 || !f.open(QIODevice::ReadOnly))
+        return;
+
+    while (!f.atEnd()) {
+        QString line = QString::fromLocal8Bit(f.readLine());
+        line = line.left(line.indexOf('#')).trimmed();
+        if (line.isEmpty())
+            continue;
+
+        if (!line.startsWith("include ")) {
+            *dirs << line;
+            continue;
+        }
+
+        // include /etc/ld.so.conf.d/*.conf
+        const QFileInfo pattern(QFileInfo(path).dir(), line.mid(8).trimmed());
+        const QDir dir = pattern.dir();
+        for (const QString &name : dir.entryList({pattern.fileName()}, QDir::Files, QDir::Name))
+            readLdConf(dir.filePath(name), dirs, depth + 1);
+    }
+}
+
+const QStringList &systemLibraryDirs() {
+    static const QStringList dirs = [] {
+        QStringList list;
+        readLdConf("/etc/ld.so.conf", &list, 0);
+        list << "/lib64" << "/usr/lib64" << "/lib" << "/usr/lib";
+        list.removeDuplicates();
+        list.removeIf([](const QString &dir) { return !QFileInfo(dir).isDir(); });
+        return list;
+    }();
+    return dirs;
+}
+
+QStringList expandOrigin(const QStringList &dirs, const QString &origin) {
+    QStringList out;
+    for (QString dir : dirs) {
+        dir.replace("${ORIGIN}", origin);
+        dir.replace("$ORIGIN", origin);
+        out << dir;
+    }
+    return out;
+}
+
+// First candidate that is an ELF object of the same class and machine
+QString findLibrary(const QString &name, const QString &origin, const ElfDeps &from,
+                    ElfDeps *deps) {
+    QStringList dirs;
+    if (from.runpath.isEmpty())
+        dirs << expandOrigin(from.rpath, origin);
+    dirs << qEnvironmentVariable("LD_LIBRARY_PATH").split(':', Qt::SkipEmptyParts);
+    dirs << expandOrigin(from.runpath, origin);
+    dirs << systemLibraryDirs();
+
+    const QStringList candidates = name.contains('/') ? QStringList{name} : [&] {
+        QStringList paths;
+        for (const QString &dir : dirs)
+            paths << dir + '/' + name;
+        return paths;
+    }();
+
+    for (const QString &path : candidates) {
+        ElfDeps lib;
+        if (!readElf(path, &lib))
+            continue;
+        if (lib.elfClass != from.elfClass || lib.machine != from.machine)
+            continue;
+        *deps = lib;
+        return path;
+    }
+    return QString();
+}
+
+// "#!/usr/bin/env python3 -u" -> the interpreter's path
+QString interpreterOf(const QString &script) {
+    QFile f(script);
+    if (!f.open(QIODevice::ReadOnly) || f.read(2) != "#!")
+        return QString();
+
+    const QStringList words = QString::fromLocal8Bit(f.readLine(256)).simplified().split(' ');
+    if (words.isEmpty() || words.first().isEmpty())
+        return QString();
+    if (QFileInfo(words.first()).fileName() != "env")
+        return words.first();
+
+    for (qsizetype i = 1; i < words.size(); ++i) {
+        if (!words[i].startsWith('-') && !words[i].contains('='))
+            return PathIndex::instance().find(words[i]);
+    }
+    return QString();
+}
+
+// Best-effort, lowest priority: launches and the UI go first
+void lowerIoPriority() {
+#ifdef SYS_ioprio_set
+    constexpr int WhoProcess = 1;     // IOPRIO_WHO_PROCESS; 0 = this thread
+    constexpr int ClassBestEffort = 2;
+    syscall(SYS_ioprio_set, WhoProcess, 0, (ClassBestEffort << 13) | 7);
+#endif
+}
+
+} // namespace
+
+// -----------------------------
+// Constructor / Destructor
+// -----------------------------
+Prefetcher::Prefetcher(QObject *parent)
+: QObject(parent) {
+    m_io.setMaxThreadCount(1);
+}
+
+Prefetcher::~Prefetcher() {
+    cancel();
+    m_io.waitForDone();
+}
+
+// -----------------------------
+// Requests
+// -----------------------------
+void Prefetcher::prefetch(const QString &program) {
+    if (program.isEmpty())
+        return;
+
+    const quint64 generation = ++m_generation;
+    m_io.start([this, program, generation]() { run(program, generation); });
+}
+
+void Prefetcher::cancel() {
+    ++m_generation;
+}
+
+void Prefetcher::run(const QString &program, quint64 generation) {
+    const auto cancelled = [this, generation]() { return m_generation.load() != generation; };
+    if (cancelled())
+        return;
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (now - m_warm.value(program, -WarmForMs) < WarmForMs)
+        return;
+
+    lowerIoPriority();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const qint64 mtime = QFileInfo(program).lastModified().toMSecsSinceEpoch();
+    auto it = m_closures.find(program);
+    if (it == m_closures.end() || it->mtime != mtime)
+        it = m_closures.insert(program, Closure{mtime, closure(program)});
+    const QStringList files = it->files;
+
+    const qint64 bytes = readahead(files, BudgetBytes, cancelled);
+    if (cancelled())
+        return;
+
+    m_warm.insert(program, now);
+    qDebug() << "📦 Prefetched" << QFileInfo(program).fileName() << files.size() << "files,"
+             << bytes / (1024 * 1024) << "MiB in" << timer.elapsed() << "ms";
+}
+
+// -----------------------------
+// Building blocks
+// -----------------------------
+QStringList Prefetcher::closure(const QString &program) {
+    QStringList files{program};
+
+    QString binary = program;
+    ElfDeps root;
+    if (!readElf(binary, &root)) {
+        binary = interpreterOf(program);
+        if (binary.isEmpty() || !readElf(binary, &root))
+            return files;
+        files << binary;
+    }
+
+    // Breadth first, the order ld.so maps them in
+    struct Object { QString path; ElfDeps deps; };
+    std::vector<Object> queue{{binary, root}};
+    QSet<QString> seen;
+    for (size_t i = 0; i < queue.size() && files.size() < MaxFiles; ++i) {
+        const Object object = queue[i];
+        const QString origin = QFileInfo(object.path).absolutePath();
+        for (const QString &name : object.deps.needed) {
+            if (seen.contains(name))
+                continue;
+            seen.insert(name);
+
+            ElfDeps deps;
+            const QString path = findLibrary(name, origin, object.deps, &deps);
+            if (path.isEmpty())
+                continue;
+            files << path;
+            queue.push_back({path, deps});
+        }
+    }
+    return files.mid(0, MaxFiles);
+}
+
+qint64 Prefetcher::readahead(const QStringList &files, qint64 budget,
+                             const std::function<bool()> &cancelled) {
+    qint64 total = 0;
+    for (const QString &path : files) {
+        const int fd = open(QFile::encodeName(path).constData(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            continue;
+
+        struct stat st;
+        const qint64 size = fstat(fd, &st) == 0 ? qint64(st.st_size) : 0;
+        for (qint64 offset = 0; offset < size && total < budget; offset += ChunkBytes) {
+            if (cancelled()) {
+                close(fd);
+                return total;
+            }
+            const qint64 length = std::min({ChunkBytes, size - offset, budget - total});
+            if (::readahead(fd, off_t(offset), size_t(length)) != 0)
+                posix_fadvise(fd, off_t(offset), off_t(length), POSIX_FADV_WILLNEED);
+            total += length;
+        }
+        close(fd);
+
+        if (total >= budget)
+            break;
+    }
+    return total;
+}
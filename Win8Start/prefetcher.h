@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+
+#include <atomic>
+#include <functional>
+
+// ----------------------------
+// Prefetcher
+// ----------------------------
+// Warms the page cache for an app the pointer or keyboard focus rests on,
+// so a cold launch does not wait on disk for its executable and shared
+// libraries. The files are the executable (or a script's interpreter) and
+// the closure of its ELF DT_NEEDED entries, searched like ld.so does:
+// DT_RPATH, LD_LIBRARY_PATH, DT_RUNPATH, then the ld.so.conf directories.
+// Libraries loaded with dlopen() are not seen.
+//
+// Work runs on a private single-thread pool at the lowest best-effort I/O
+// priority, one readahead() chunk at a time. Each prefetch reads at most
+// BudgetBytes; a new prefetch or cancel() stops the one in flight between
+// chunks.
+class Prefetcher : public QObject {
+    Q_OBJECT
+public:
+    static constexpr qint64 BudgetBytes = 192ll * 1024 * 1024;
+    static constexpr int MaxFiles = 256;
+    static constexpr qint64 WarmForMs = 5 * 60 * 1000;   // skip a repeat
+
+    explicit Prefetcher(QObject *parent = nullptr);
+    ~Prefetcher() override;
+
+    // `program` is an absolute path
+    void prefetch(const QString &program);
+    void cancel();
+
+    // Building blocks, also used by the benchmark. `cancelled` is polled
+    // between chunks; readahead() returns the bytes requested.
+    static QStringList closure(const QString &program);
+    static qint64 readahead(const QStringList &files, qint64 budget,
+                            const std::function<bool()> &cancelled);
+
+private:
+    struct Closure {
+        qint64 mtime = 0;
+        QStringList files;
+    };
+
+    QThreadPool m_io;
+    std::atomic<quint64> m_generation{0};
+
+    // Owned by the worker thread
+    QHash<QString, Closure> m_closures;
+    QHash<QString, qint64> m_warm;     // program -> when it was read in full
+
+    void run(const QString &program, quint64 generation);
+};
@@ -0,0 +1,332 @@
+#include "searchindex.h"
+
+#include <algorithm>
+
+namespace {
+
+enum FieldWeight {
+    NameWeight = 0,
+    GenericNameWeight = 10,
+    KeywordWeight = 20
+};
+
+// Substring match; prefix matches are found through the word table
+constexpr int ContainsTier = 2;
+
+// Offsets from FuzzyBase + weight
+constexpr int SubsequenceTier = 0;
+constexpr int TypoTier = 1;
+
+bool hasSpace(QStringView s) {
+    for (QChar c : s) {
+        if (c.isSpace())
+            return true;
+    }
+    return false;
+}
+
+} // namespace
+
+// -----------------------------
+// Build
+// -----------------------------
+void SearchIndex::build(const QList<AppInfo> &apps) {
+    m_fields.clear();
+    m_fieldBegin.clear();
+    m_words.clear();
+    m_categories.clear();
+
+    m_fieldBegin.reserve(size_t(apps.size()) + 1);
+
+    auto addField = [this](const QString &text, int weight) {
+        if (text.isEmpty())
+            return;
+
+        Field f;
+        f.text = text.toCaseFolded();
+        f.charMask = FuzzyMatcher::charMask(f.text);
+        f.weight = weight;
+        for (int i = 1; i < f.text.size(); ++i) {
+            if (f.text[i - 1].isSpace() && !f.text[i].isSpace())
+                f.wordStarts.push_back(i);
+        }
+        m_fields.push_back(std::move(f));
+    };
+
+    for (int i = 0; i < apps.size(); ++i) {
+        const AppInfo &app = apps[i];
+        m_fieldBegin.push_back(int(m_fields.size()));
+
+        addField(app.name, NameWeight);
+        addField(app.genericName, GenericNameWeight);
+        for (const QString &kw : app.keywords)
+            addField(kw, KeywordWeight);
+
+        for (const QString &category : app.categories) {
+            QBitArray &bits = m_categories[category.toCaseFolded()];
+            if (bits.isEmpty())
+                bits.resize(apps.size());
+            bits.setBit(i);
+        }
+    }
+    m_fieldBegin.push_back(int(m_fields.size()));
+
+    // Word table; m_fields no longer grows, so the views stay valid
+    for (int app = 0; app < apps.size(); ++app) {
+        for (int f = m_fieldBegin[size_t(app)]; f < m_fieldBegin[size_t(app) + 1]; ++f) {
+            const Field &field = m_fields[size_t(f)];
+            const QStringView text(field.text);
+
+            auto wordAt = [&](int start) {
+                int end = start;
+                while (end < text.size() && !text[end].isSpace())
+                    ++end;
+                return text.sliced(start, end - start);
+            };
+
+            if (!text.front().isSpace())
+                m_words.push_back({wordAt(0), app, field.weight, true});
+            for (int start : field.wordStarts)
+                m_words.push_back({wordAt(start), app, field.weight, false});
+        }
+    }
+
+    std::sort(m_words.begin(), m_words.end(),
+              [](const Word &a, const Word &b) { return a.text < b.text; });
+}
+
+SearchIndex::Query::Query(const QString &text, bool fuzzy)
+: folded(text.toCaseFolded())
+, fuzzy(fuzzy)
+, matcher(fuzzy ? folded : QString()) {}
+
+// -----------------------------
+// Scoring
+// -----------------------------
+int SearchIndex::tier(const Field &field, QStringView query) {
+    const QStringView text(field.text);
+    if (text.startsWith(query))
+        return 0;
+    for (int start : field.wordStarts) {
+        if (text.sliced(start).startsWith(query))
+            return 1;
+    }
+    if (text.contains(query))
+        return ContainsTier;
+    return NoMatch;
+}
+
+// The full list stays alphabetical unless "Most used" is chosen
+double SearchIndex::frecencyOf(int index, const Query &query) {
+    if (!query.frecency || size_t(index) >= query.frecency->size())
+        return 0;
+    if (query.folded.isEmpty() && !query.mostUsed)
+        return 0;
+    return (*query.frecency)[size_t(index)];
+}
+
+bool SearchIndex::lessThan(const Match &a, const Match &b) {
+    if (a.score != b.score)
+        return a.score < b.score;
+    if (a.bonus != b.bonus)
+        return a.bonus > b.bonus;
+    if (a.frecency != b.frecency)
+        return a.frecency > b.frecency;
+    return a.index < b.index;
+}
+
+// Only for apps without an exact match; fields in weight order, so the
+// first field that matches decides the tier
+void SearchIndex::matchFuzzy(int index, const FuzzyMatcher &matcher, Match *m) const {
+    const int begin = m_fieldBegin[size_t(index)];
+    const int end = m_fieldBegin[size_t(index) + 1];
+
+    for (int f = begin; f < end; ++f) {
+        const Field &field = m_fields[size_t(f)];
+        const int s = FuzzyBase + field.weight + SubsequenceTier;
+        if (s > m->score)
+            break;
+        const int fuzzy = matcher.subsequence(field.text, field.charMask);
+        if (fuzzy >= 0 && (s < m->score || fuzzy > m->bonus)) {
+            m->score = s;
+            m->bonus = fuzzy;
+        }
+    }
+    if (m->score < NoMatch || matcher.maxTypos() == 0)
+        return;
+
+    for (int f = begin; f < end; ++f) {
+        const Field &field = m_fields[size_t(f)];
+        const int s = FuzzyBase + field.weight + TypoTier;
+        if (s > m->score)
+            break;
+        const int typos = matcher.editDistance(field.text, field.charMask);
+        if (typos <= matcher.maxTypos() && (s < m->score || -typos > m->bonus)) {
+            m->score = s;
+            m->bonus = -typos;
+        }
+    }
+}
+
+SearchIndex::Match SearchIndex::match(int index, const Query &query) const {
+    const QString &q = query.folded;
+    Match m{index, NoMatch, 0, frecencyOf(index, query)};
+    if (q.isEmpty()) {
+        m.score = EmptyQuery;
+        return m;
+    }
+
+    for (int f = m_fieldBegin[size_t(index)]; f < m_fieldBegin[size_t(index) + 1]; ++f) {
+        const Field &field = m_fields[size_t(f)];
+        if (field.weight >= m.score)
+            continue;
+        m.score = std::min(m.score, field.weight + tier(field, q));
+    }
+
+    if (m.score >= NoMatch && query.matcher.isEnabled())
+        matchFuzzy(index, query.matcher, &m);
+    return m;
+}
+
+bool SearchIndex::inCategory(int index, const QString &category) const {
+    if (category.isEmpty())
+        return true;
+    auto it = m_categories.constFind(category.toCaseFolded());
+    return it != m_categories.constEnd() && it->testBit(index);
+}
+
+// -----------------------------
+// Search
+// -----------------------------
+bool SearchIndex::collect(const Query &query, const QString &category, State *state,
+                          std::vector<Match> *matches, const CancelFn &cancelled) const {
+    const QString &q = query.folded;
+    const QString cat = category.toCaseFolded();
+    const int count = size();
+
+    const QBitArray *catBits = nullptr;
+    if (!cat.isEmpty()) {
+        auto it = m_categories.constFind(cat);
+        if (it != m_categories.constEnd())
+            catBits = &*it;
+    }
+
+    const FuzzyMatcher &matcher = query.matcher;
+    const bool fuzzy = matcher.isEnabled();
+
+    // Every app matching "fir" also matched "fi", so only those are
+    // checked. Fuzzy matches are monotonic too, as long as the number of
+    // allowed typos did not grow with the query.
+    const bool refine = state && state->valid && !state->query.isEmpty()
+                        && cat == state->category && q.startsWith(state->query)
+                        && state->fuzzy == query.fuzzy
+                        && (!query.fuzzy || FuzzyMatcher::maxTyposFor(state->query.size())
+                                                == matcher.maxTypos())
+                        && (!fuzzy || state->query.size() >= FuzzyMatcher::MinLength);
+
+    std::vector<int> candidates;
+    if (refine) {
+        candidates = state->matches;
+    } else if (cat.isEmpty() || catBits) {
+        candidates.reserve(size_t(std::max(count, 0)));
+        for (int i = 0; i < count; ++i) {
+            if (!catBits || catBits->testBit(i))
+                candidates.push_back(i);
+        }
+    }
+
+    // Polled every few hundred apps, so a stale search stops early
+    auto stop = [&cancelled](size_t n) {
+        return cancelled && (n & 255) == 0 && cancelled();
+    };
+
+    std::vector<int> best(size_t(std::max(count, 0)), NoMatch);
+
+    if (q.isEmpty()) {
+        for (int i : candidates)
+            best[size_t(i)] = EmptyQuery;
+    } else if (!hasSpace(q)) {
+        std::vector<char> isCandidate(best.size(), 0);
+        for (int i : candidates)
+            isCandidate[size_t(i)] = 1;
+
+        // 1. Word prefixes from the sorted table
+        auto it = std::lower_bound(m_words.begin(), m_words.end(), QStringView(q),
+                                   [](const Word &w, QStringView key) { return w.text < key; });
+        for (; it != m_words.end() && it->text.startsWith(q); ++it) {
+            if (!isCandidate[size_t(it->app)])
+                continue;
+            int &b = best[size_t(it->app)];
+            b = std::min(b, it->weight + (it->first ? 0 : 1));
+        }
+
+        // 2. Substrings, only for fields that could still improve the score
+        for (size_t n = 0; n < candidates.size(); ++n) {
+            if (stop(n))
+                return false;
+            const int i = candidates[n];
+            int &b = best[size_t(i)];
+            for (int f = m_fieldBegin[size_t(i)]; f < m_fieldBegin[size_t(i) + 1]; ++f) {
+                const Field &field = m_fields[size_t(f)];
+                if (field.weight + ContainsTier < b && field.text.contains(q))
+                    b = field.weight + ContainsTier;
+            }
+        }
+    } else {
+        // Queries with spaces never match a single word
+        for (size_t n = 0; n < candidates.size(); ++n) {
+            if (stop(n))
+                return false;
+            const int i = candidates[n];
+            int &b = best[size_t(i)];
+            for (int f = m_fieldBegin[size_t(i)]; f < m_fieldBegin[size_t(i) + 1]; ++f) {
+                const Field &field = m_fields[size_t(f)];
+                if (field.weight < b)
+                    b = std::min(b, field.weight + tier(field, q));
+            }
+        }
+    }
+
+    std::vector<int> matched;
+    matches->clear();
+    matches->reserve(candidates.size());
+    matched.reserve(candidates.size());
+
+    for (size_t n = 0; n < candidates.size(); ++n) {
+        if (fuzzy && stop(n))
+            return false;
+        const int i = candidates[n];
+        Match m{i, best[size_t(i)], 0, frecencyOf(i, query)};
+        if (m.score == NoMatch && fuzzy)
+            matchFuzzy(i, matcher, &m);
+        if (m.score >= NoMatch && m.score != EmptyQuery)
+            continue;
+        matches->push_back(m);
+        matched.push_back(i);
+    }
+
+    if (state) {
+        state->valid = true;
+        state->query = q;
+        state->category = cat;
+        state->fuzzy = query.fuzzy;
+        state->matches = std::move(matched);
+    }
+    return true;
+}
+
+std::vector<SearchIndex::Match> SearchIndex::search(const Query &query,
+                                                    const QString &category,
+                                                    int limit, State *state) const {
+    std::vector<Match> matches;
+    collect(query, category, state, &matches);
+
+    if (limit >= 0 && size_t(limit) < matches.size()) {
+        std::partial_sort(matches.begin(), matches.begin() + limit, matches.end(), lessThan);
+        matches.resize(size_t(limit));
+    } else {
+        std::sort(matches.begin(), matches.end(), lessThan);
+    }
+
+    return matches;
+}
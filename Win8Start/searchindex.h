@@ -0,0 +1,113 @@
+#pragma once
+
+#include <QBitArray>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringView>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "appindex.h"
+#include "fuzzymatch.h"
+
+// ----------------------------
+// SearchIndex
+// ----------------------------
+// Case-folded copy of the searchable AppInfo fields, built once per app
+// list change. Every word is also in a prefix-sorted table, and every
+// category has a bitset over the apps, so a keystroke does not lowercase,
+// split or allocate per app.
+//
+// The index is immutable once built and may be searched from several
+// threads; refinement state is owned by the caller.
+//
+// Scores follow the launcher's ranking: the name starting with the query
+// is best, then a word starting with it, then a substring match; the
+// generic name ranks 10 and keywords 20 below the name. With fuzzy
+// matching on, apps without any of those are ranked after them by a
+// subsequence match, then by a match with a typo or two, again name
+// before generic name before keywords. Within a score, apps launched
+// more often and more lately come first, then the list (name) order.
+class SearchIndex {
+public:
+    static constexpr int NoMatch = 100;
+    static constexpr int EmptyQuery = 1000;
+    static constexpr int FuzzyBase = 30;    // first score of the fuzzy tiers
+
+    struct Match {
+        int index;      // into the list given to build()
+        int score;      // lower is better
+        int bonus = 0;  // higher is better, among equal scores
+        double frecency = 0;   // higher is better, among equal bonuses
+    };
+
+    // A query folded once, with its fuzzy tables
+    struct Query {
+        Query(const QString &text = QString(), bool fuzzy = true);
+
+        QString folded;
+        bool fuzzy;
+        FuzzyMatcher matcher;
+
+        // Per app in list order, from LaunchLog; none ranks by name only
+        std::shared_ptr<const std::vector<double>> frecency;
+        bool mostUsed = false;   // the empty query ranks by frecency too
+    };
+
+    // The previous search, so that "fir" after "fi" only re-checks the
+    // apps that matched "fi"
+    struct State {
+        bool valid = false;
+        QString query;
+        QString category;
+        bool fuzzy = false;
+        std::vector<int> matches;     // in list order
+    };
+
+    using CancelFn = std::function<bool()>;
+
+    static bool lessThan(const Match &a, const Match &b);
+
+    void build(const QList<AppInfo> &apps);
+    int size() const { return int(m_fieldBegin.size()) - 1; }
+
+    Match match(int index, const Query &query) const;
+    bool inCategory(int index, const QString &category) const;
+
+    // Apps in `category` (empty = all) that match `query`, unordered.
+    // Updates `state` when given; returns false when `cancelled` fired.
+    bool collect(const Query &query, const QString &category, State *state,
+                 std::vector<Match> *matches, const CancelFn &cancelled = {}) const;
+
+    // collect(), best score first and in list order within a score. With
+    // a limit only the top `limit` are selected.
+    std::vector<Match> search(const Query &query, const QString &category,
+                              int limit = -1, State *state = nullptr) const;
+
+private:
+    struct Field {
+        QString text;                  // case folded
+        std::vector<int> wordStarts;   // offsets after whitespace, excluding 0
+        quint64 charMask;              // FuzzyMatcher::charMask(text)
+        int weight;
+    };
+
+    struct Word {
+        QStringView text;              // into Field::text
+        int app;
+        int weight;
+        bool first;                    // starts the field
+    };
+
+    std::vector<Field> m_fields;
+    std::vector<int> m_fieldBegin;     // per app, into m_fields; one extra at the end
+    std::vector<Word> m_words;         // sorted by text
+    QHash<QString, QBitArray> m_categories;   // folded category -> apps
+
+    static int tier(const Field &field, QStringView query);
+    static double frecencyOf(int index, const Query &query);
+    void matchFuzzy(int index, const FuzzyMatcher &matcher, Match *m) const;
+};
@@ -0,0 +1,196 @@
+#include "spawnclient.h"
+#include "pathindex.h"
+#include "spawnprotocol.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QProcess>
+#include <QSocketNotifier>
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+using namespace SpawnProtocol;
+
+SpawnClient::SpawnClient(QObject *parent)
+: QObject(parent) {}
+
+SpawnClient::~SpawnClient() {
+    m_pending.clear();    // nobody left to tell
+    stop();
+}
+
+// -----------------------------
+// Helper process
+// -----------------------------
+QString SpawnClient::helperPath() {
+    const QString local = QCoreApplication::applicationDirPath() + "/win8start-spawner";
+    if (QFileInfo(local).isExecutable())
+        return local;
+    return PathIndex::instance().find("win8start-spawner");
+}
+
+bool SpawnClient::start() {
+    if (m_fd >= 0)
+        return true;
+
+    QByteArray path = helperPath().toLocal8Bit();
+    if (path.isEmpty()) {
+        qWarning() << "⚠️ win8start-spawner not found, launching in-process";
+        return false;
+    }
+
+    int sv[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sv) != 0) {
+        qWarning() << "⚠️ Spawn helper socketpair failed:" << std::strerror(errno);
+        return false;
+    }
+
+    // dup2 onto itself would keep FD_CLOEXEC
+    if (sv[1] == HelperFd)
+        fcntl(sv[1], F_SETFD, 0);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    if (sv[1] != HelperFd)
+        posix_spawn_file_actions_adddup2(&actions, sv[1], HelperFd);
+
+    char *argv[] = {path.data(), nullptr};
+    const int error = posix_spawn(&m_helper, path.constData(), &actions, nullptr, argv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(sv[1]);
+
+    if (error != 0) {
+        qWarning() << "⚠️ Could not start win8start-spawner:" << std::strerror(error);
+        close(sv[0]);
+        m_helper = -1;
+        return false;
+    }
+
+    m_fd = sv[0];
+    fcntl(m_fd, F_SETFL, fcntl(m_fd, F_GETFL) | O_NONBLOCK);
+
+    m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &SpawnClient::readReplies);
+
+    qDebug() << "🚀 Spawn helper running, pid" << m_helper;
+    return true;
+}
+
+void SpawnClient::stop() {
+    if (m_fd < 0)
+        return;
+
+    delete m_notifier;
+    m_notifier = nullptr;
+    close(m_fd);
+    m_fd = -1;
+
+    // It exits on EOF; reap it if it already has
+    if (m_helper > 0)
+        waitpid(m_helper, nullptr, WNOHANG);
+    m_helper = -1;
+
+    // Replies that will never come
+    const QSet<quint32> pending = std::exchange(m_pending, {});
+    for (quint32 id : pending)
+        emit spawnFailed(id, "spawn helper exited");
+}
+
+// -----------------------------
+// Requests
+// -----------------------------
+quint32 SpawnClient::spawn(const QStringList &argv, const QString &workingDir) {
+    const quint32 id = m_nextId++;
+    const QString cwd = workingDir.isEmpty() ? QDir::homePath() : workingDir;
+    if (argv.isEmpty()) {
+        QMetaObject::invokeMethod(this, [this, id]() { emit spawnFailed(id, "empty command"); },
+                                  Qt::QueuedConnection);
+        return id;
+    }
+
+    if ((m_fd >= 0 || start()) && send(id, argv, cwd)) {
+        m_pending.insert(id);
+        return id;
+    }
+
+    spawnFallback(id, argv, cwd);
+    return id;
+}
+
+bool SpawnClient::send(quint32 id, const QStringList &argv, const QString &cwd) {
+    Request r{};
+    r.id = id;
+    r.argc = quint32(argv.size());
+
+    QByteArray strings = cwd.toLocal8Bit();
+    strings.append('\0');
+    for (const QString &arg : argv) {
+        strings.append(arg.toLocal8Bit());
+        strings.append('\0');
+    }
+    for (char **env = environ; *env; ++env) {
+        strings.append(*env);
+        strings.append('\0');
+        ++r.envc;
+    }
+
+    QByteArray packet(reinterpret_cast<const char *>(&r), sizeof(r));
+    packet.append(strings);
+    if (size_t(packet.size()) > MaxRequestSize)
+        return false;
+
+    const ssize_t n = ::send(m_fd, packet.constData(), size_t(packet.size()),
+                             MSG_NOSIGNAL | MSG_DONTWAIT);
+    if (n == packet.size())
+        return true;
+
+    if (n < 0 && errno != EAGAIN)
+        stop();
+    return false;
+}
+
+// Same result, but forked from this process
+void SpawnClient::spawnFallback(quint32 id, const QStringList &argv, const QString &cwd) {
+    qint64 pid = -1;
+    const bool ok = QProcess::startDetached(argv.first(), argv.mid(1), cwd, &pid);
+    QMetaObject::invokeMethod(this, [this, id, ok, pid]() {
+        if (ok)
+            emit spawned(id, pid);
+        else
+            emit spawnFailed(id, "could not start the process");
+    }, Qt::QueuedConnection);
+}
+
+void SpawnClient::readReplies() {
+    for (;;) {
+        Reply reply;
+        const ssize_t n = recv(m_fd, &reply, sizeof(reply), MSG_DONTWAIT);
+        if (n < 0 && (errno == EAGAIN || errno == EINTR))
+            return;
+        if (n <= 0) {
+            qWarning() << "⚠️ Spawn helper went away; restarting on the next launch";
+            stop();
+            return;
+        }
+        if (size_t(n) != sizeof(reply))
+            continue;
+
+        m_pending.remove(reply.id);
+        if (reply.error == 0)
+            emit spawned(reply.id, reply.pid);
+        else
+            emit spawnFailed(reply.id, QString::fromLocal8Bit(std::strerror(reply.error)));
+    }
+}
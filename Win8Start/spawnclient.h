@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include <sys/types.h>
+
+class QSocketNotifier;
+
+// ----------------------------
+// SpawnClient
+// ----------------------------
+// Hands launches to win8start-spawner, a small helper process started
+// with Win8Start, so that the Start menu never forks itself. Requests
+// are single non-blocking packets; replies (the child pid) arrive through
+// the event loop.
+//
+// When the helper cannot be started or the request cannot be sent,
+// spawn() falls back to QProcess::startDetached on the calling thread.
+class SpawnClient : public QObject {
+    Q_OBJECT
+public:
+    explicit SpawnClient(QObject *parent = nullptr);
+    ~SpawnClient() override;
+
+    bool start();
+    bool isRunning() const { return m_fd >= 0; }
+
+    // `argv[0]` is an absolute path; the current environment is passed
+    // along. The child starts in `cwd`, or in $HOME when it is empty, as
+    // the helper itself sits in /. Returns the request id that spawned() /
+    // spawnFailed() report.
+    quint32 spawn(const QStringList &argv, const QString &cwd = QString());
+
+signals:
+    void spawned(quint32 id, qint64 pid);
+    void spawnFailed(quint32 id, const QString &error);
+
+private:
+    int m_fd = -1;
+    pid_t m_helper = -1;
+    QSocketNotifier *m_notifier = nullptr;
+    quint32 m_nextId = 1;
+    QSet<quint32> m_pending;      // sent, no reply yet
+
+    static QString helperPath();
+    bool send(quint32 id, const QStringList &argv, const QString &cwd);
+    void spawnFallback(quint32 id, const QStringList &argv, const QString &cwd);
+    void readReplies();
+    void stop();
+};
@@ -0,0 +1,133 @@
+// win8start-spawner: launches applications for Win8Start.
+//
+// Started by Win8Start with its end of a socketpair on fd 3. Each request
+// is spawned with posix_spawn from this small process image instead of
+// forking the Start menu (a large Qt GUI process with many descriptors),
+// and the child's pid is sent back. Exits when Win8Start goes away.
+//
+// Children get their own session, default signal dispositions and an
+// empty signal mask; they are reaped by the kernel (SIGCHLD is ignored).
+
+#include "spawnprotocol.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SpawnProtocol;
+
+namespace {
+
+// Splits the string block after the header; false when it is malformed
+bool parseRequest(char *data, size_t size, const char **cwd,
+                  std::vector<char *> *argv, std::vector<char *> *envp) {
+    if (size < sizeof(Request))
+        return false;
+    Request r;
+    std::memcpy(&r, data, sizeof(r));
+    if (r.argc == 0 || r.argc > size || r.envc > size)
+        return false;
+
+    char *p = data + sizeof(Request);
+    char *end = data + size;
+    std::vector<char *> strings;
+    while (p < end) {
+        char *nul = static_cast<char *>(std::memchr(p, '\0', size_t(end - p)));
+        if (!nul)
+            return false;
+        strings.push_back(p);
+        p = nul + 1;
+    }
+    if (strings.size() != size_t(1) + r.argc + r.envc)
+        return false;
+
+    *cwd = strings[0];
+    argv->assign(strings.begin() + 1, strings.begin() + 1 + r.argc);
+    argv->push_back(nullptr);
+    envp->assign(strings.begin() + 1 + r.argc, strings.end());
+    envp->push_back(nullptr);
+    return true;
+}
+
+int spawn(const char *cwd, char *const argv[], char *const envp[], pid_t *pid) {
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+
+    sigset_t none, all;
+    sigemptyset(&none);
+    sigfillset(&all);
+    posix_spawnattr_setsigmask(&attr, &none);
+    posix_spawnattr_setsigdefault(&attr, &all);
+
+    short flags = POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF;
+#ifdef POSIX_SPAWN_SETSID
+    flags |= POSIX_SPAWN_SETSID;    // not killed with the Start menu's session
+#endif
+    posix_spawnattr_setflags(&attr, flags);
+
+    // Single-threaded, so changing our own cwd around the spawn is safe
+    const bool changedDir = cwd[0] != '\0' && chdir(cwd) == 0;
+    const int error = posix_spawn(pid, argv[0], nullptr, &attr, argv, envp);
+    if (changedDir && chdir("/") != 0)
+        std::perror("win8start-spawner: chdir");
+
+    posix_spawnattr_destroy(&attr);
+    return error;
+}
+
+} // namespace
+
+int main() {
+    struct stat st;
+    if (fstat(HelperFd, &st) != 0 || !S_ISSOCK(st.st_mode)) {
+        std::fputs("win8start-spawner: only started by Win8Start\n", stderr);
+        return 2;
+    }
+
+    // Not inherited by the applications
+    fcntl(HelperFd, F_SETFD, FD_CLOEXEC);
+    // Only for the helper's own idle state; every request names the
+    // child's working directory
+    if (chdir("/") != 0)
+        std::perror("win8start-spawner: chdir");
+
+    std::signal(SIGCHLD, SIG_IGN);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::vector<char> buffer(MaxRequestSize);
+    for (;;) {
+        const ssize_t n = recv(HelperFd, buffer.data(), buffer.size(), 0);
+        if (n == 0)
+            return 0;               // Win8Start exited
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return 1;
+        }
+
+        Reply reply{};
+        std::memcpy(&reply.id, buffer.data(), std::min(sizeof(reply.id), size_t(n)));
+
+        const char *cwd = "";
+        std::vector<char *> argv, envp;
+        if (!parseRequest(buffer.data(), size_t(n), &cwd, &argv, &envp)) {
+            reply.error = EINVAL;
+        } else {
+            pid_t pid = -1;
+            reply.error = spawn(cwd, argv.data(), envp.data(), &pid);
+            reply.pid = reply.error == 0 ? pid : -1;
+        }
+
+        if (send(HelperFd, &reply, sizeof(reply), MSG_NOSIGNAL) < 0 && errno == EPIPE)
+            return 0;
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// ----------------------------
+// Spawn helper protocol
+// ----------------------------
+// Win8Start and win8start-spawner talk over a SOCK_SEQPACKET socketpair,
+// one request or reply per packet, native endian (both ends are the same
+// build). Plain C++ so the helper does not link Qt.
+namespace SpawnProtocol {
+
+constexpr int HelperFd = 3;                    // the helper's end of the socketpair
+constexpr size_t MaxRequestSize = 64 * 1024;   // larger requests use the fallback
+
+// Followed by NUL-terminated strings: cwd (may be empty), argv[argc],
+// envp[envc]. argv[0] is an absolute path.
+struct Request {
+    uint32_t id;
+    uint32_t argc;
+    uint32_t envc;
+    uint32_t reserved;
+};
+
+struct Reply {
+    uint32_t id;
+    int32_t error;      // errno from posix_spawn, 0 on success
+    int64_t pid;
+};
+
+static_assert(sizeof(Request) == 16, "spawn request layout changed");
+static_assert(sizeof(Reply) == 16, "spawn reply layout changed");
+
+} // namespace SpawnProtocol
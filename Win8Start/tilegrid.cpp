@@ -0,0 +1,298 @@
+#include "tilegrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// -----------------------------
+// Occupancy
+// -----------------------------
+void TileGrid::reset(int columns, int rows) {
+    m_columns = std::max(0, columns);
+    m_rows = std::max(0, rows);
+    m_owner.assign(size_t(m_columns) * size_t(m_rows), -1);
+    m_count.assign(m_owner.size(), 0);
+    m_rects.clear();
+}
+
+void TileGrid::clear() {
+    reset(m_columns, m_rows);
+}
+
+void TileGrid::place(int tile, const TileRect &rect) {
+    if (tile < 0)
+        return;
+    remove(tile);
+    if (tile >= m_rects.size())
+        m_rects.resize(tile + 1);
+    m_rects[tile] = rect;
+    mark(rect, tile, +1);
+}
+
+void TileGrid::remove(int tile) {
+    if (tile < 0 || tile >= m_rects.size() || m_rects[tile].isNull())
+        return;
+    mark(m_rects[tile], tile, -1);
+    m_rects[tile] = TileRect();
+}
+
+TileRect TileGrid::rect(int tile) const {
+    return tile >= 0 && tile < m_rects.size() ? m_rects[tile] : TileRect();
+}
+
+void TileGrid::mark(const TileRect &rect, int tile, int delta) {
+    for (int r = std::max(rect.row, 0); r < std::min(rect.row + rect.rows, m_rows); ++r) {
+        for (int c = std::max(rect.col, 0); c < std::min(rect.col + rect.cols, m_columns); ++c) {
+            const int cell = cellAt(c, r);
+            m_count[cell] = quint16(m_count[cell] + delta);
+            if (delta > 0) {
+                m_owner[cell] = tile;
+                continue;
+            }
+            if (m_owner[cell] != tile)
+                continue;
+
+            // Overlapping tiles: hand the cell to another one that covers it
+            m_owner[cell] = -1;
+            for (int i = 0; m_count[cell] > 0 && i < m_rects.size(); ++i) {
+                if (i != tile && m_rects[i].contains(c, r)) {
+                    m_owner[cell] = i;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// -----------------------------
+// Queries
+// -----------------------------
+QList<int> TileGrid::tilesInColumns(int first, int last) const {
+    first = std::max(first, 0);
+    last = std::min(last, m_columns - 1);
+
+    QList<int> tiles;
+    std::vector<bool> seen(size_t(m_rects.size()), false);
+    bool overlapped = false;
+
+    for (int c = first; c <= last; ++c) {
+        for (int r = 0; r < m_rows; ++r) {
+            const int cell = cellAt(c, r);
+            overlapped = overlapped || m_count[cell] > 1;
+            const int tile = m_owner[cell];
+            if (tile >= 0 && !seen[size_t(tile)]) {
+                seen[size_t(tile)] = true;
+                tiles << tile;
+            }
+        }
+    }
+
+    // A cell only names the last of several overlapping tiles
+    if (overlapped) {
+        for (int i = 0; i < m_rects.size(); ++i) {
+            const TileRect &rect = m_rects[i];
+            if (!seen[size_t(i)] && !rect.isNull() && rect.col <= last && rect.col + rect.cols > first)
+                tiles << i;
+        }
+    }
+
+    std::sort(tiles.begin(), tiles.end());
+    return tiles;
+}
+
+bool TileGrid::isFree(int col, int row, int exclude) const {
+    if (!inGrid(col, row))
+        return false;
+    const int covered = m_count[cellAt(col, row)];
+    return covered == 0 || (covered == 1 && rect(exclude).contains(col, row));
+}
+
+bool TileGrid::fits(const TileRect &rect, int exclude) const {
+    if (rect.isNull() || rect.col < 0 || rect.row < 0
+        || rect.col + rect.cols > m_columns || rect.row + rect.rows > m_rows)
+        return false;
+
+    for (int r = rect.row; r < rect.row + rect.rows; ++r) {
+        for (int c = rect.col; c < rect.col + rect.cols; ++c) {
+            if (!isFree(c, r, exclude))
+                return false;
+        }
+    }
+    return true;
+}
+
+std::optional<QPoint> TileGrid::nearestFree(const TileRect &rect, int maxSteps, int exclude) const {
+    if (fits(rect, exclude))
+        return QPoint(rect.col, rect.row);
+
+    // Row by row, then column by column; the first at the shortest
+    // distance wins
+    std::optional<QPoint> best;
+    int bestDist = std::numeric_limits<int>::max();
+    for (int dr = -maxSteps; dr <= maxSteps; ++dr) {
+        for (int dc = -maxSteps; dc <= maxSteps; ++dc) {
+            const int dist = std::abs(dc) + std::abs(dr);
+            if (dist == 0 || dist >= bestDist)
+                continue;
+            TileRect moved = rect;
+            moved.col += dc;
+            moved.row += dr;
+            if (fits(moved, exclude)) {
+                best = QPoint(moved.col, moved.row);
+                bestDist = dist;
+            }
+        }
+    }
+    return best;
+}
+
+std::optional<QPoint> TileGrid::firstFree(int cols, int rows) const {
+    for (int c = 0; c + cols <= m_columns; ++c) {
+        for (int r = 0; r + rows <= m_rows; ++r) {
+            if (fits({c, r, cols, rows}))
+                return QPoint(c, r);
+        }
+    }
+    return std::nullopt;
+}
+
+// -----------------------------
+// Keyboard navigation
+// -----------------------------
+int TileGrid::neighbour(int tile, int dx, int dy) const {
+    const TileRect from = rect(tile);
+    if (from.isNull() || (dx == 0 && dy == 0))
+        return -1;
+
+    const double cx = from.col + from.cols / 2.0;
+    const double cy = from.row + from.rows / 2.0;
+
+    const auto distanceTo = [&](const TileRect &r) {
+        return std::hypot(r.col + r.cols / 2.0 - cx, r.row + r.rows / 2.0 - cy);
+    };
+    const auto inDirection = [&](const TileRect &r) {
+        const double vx = r.col + r.cols / 2.0 - cx;
+        const double vy = r.row + r.rows / 2.0 - cy;
+        return (dx == 0 || (vx > 0 ? 1 : vx < 0 ? -1 : 0) == dx)
+               && (dy == 0 || (vy > 0 ? 1 : vy < 0 ? -1 : 0) == dy);
+    };
+
+    int best = -1;
+    double bestDist = std::numeric_limits<double>::infinity();
+    const auto consider = [&](int other) {
+        if (other < 0 || other == tile)
+            return;
+        const TileRect r = rect(other);
+        if (!inDirection(r))
+            return;
+        const double dist = distanceTo(r);
+        if (dist < bestDist) {
+            bestDist = dist;
+            best = other;
+        }
+    };
+
+    // Aligned: walk the tile's own row band (or column band) outward,
+    // until a line is further away than the best tile found
+    if (dx != 0) {
+        const int r0 = std::max(from.row, 0), r1 = std::min(from.row + from.rows, m_rows);
+        for (int c = dx > 0 ? from.col + from.cols : from.col - 1; c >= 0 && c < m_columns; c += dx) {
+            const double edge = dx > 0 ? c - cx : cx - (c + 1);
+            if (edge >= bestDist)
+                break;
+            for (int r = r0; r < r1; ++r)
+                consider(m_owner[cellAt(c, r)]);
+        }
+    } else {
+        const int c0 = std::max(from.col, 0), c1 = std::min(from.col + from.cols, m_columns);
+        for (int r = dy > 0 ? from.row + from.rows : from.row - 1; r >= 0 && r < m_rows; r += dy) {
+            const double edge = dy > 0 ? r - cy : cy - (r + 1);
+            if (edge >= bestDist)
+                break;
+            for (int c = c0; c < c1; ++c)
+                consider(m_owner[cellAt(c, r)]);
+        }
+    }
+    if (best >= 0)
+        return best;
+
+    // Nothing in the band: the closest tile in that direction
+    for (int i = 0; i < m_rects.size(); ++i) {
+        if (!m_rects[i].isNull())
+            consider(i);
+    }
+    return best;
+}
+
+// -----------------------------
+// Compaction
+// -----------------------------
+bool TileGrid::columnEmpty(int col) const {
+    for (int r = 0; r < m_rows; ++r) {
+        if (m_count[cellAt(col, r)] > 0)
+            return false;
+    }
+    return true;
+}
+
+QList<std::pair<int, QPoint>> TileGrid::compactGroup(int tile) const {
+    const TileRect from = rect(tile);
+    int c0 = std::max(from.col, 0);
+    int c1 = std::min(from.col + from.cols, m_columns) - 1;
+    if (from.isNull() || c0 > c1)
+        return {};
+
+    while (c0 > 0 && !columnEmpty(c0 - 1))
+        --c0;
+    while (c1 < m_columns - 1 && !columnEmpty(c1 + 1))
+        ++c1;
+
+    // Tiles inside the group, top first; anything sticking out of the
+    // grid stays where it is and keeps its cells
+    const int width = c1 - c0 + 1;
+    std::vector<char> used(size_t(width) * size_t(m_rows), 0);
+    const auto setUsed = [&](const TileRect &r) {
+        for (int y = std::max(r.row, 0); y < std::min(r.row + r.rows, m_rows); ++y)
+            for (int x = std::max(r.col, c0); x < std::min(r.col + r.cols, c1 + 1); ++x)
+                used[size_t(y) * width + size_t(x - c0)] = 1;
+    };
+
+    QList<int> members;
+    for (int i = 0; i < m_rects.size(); ++i) {
+        const TileRect &r = m_rects[i];
+        if (r.isNull() || r.col + r.cols <= c0 || r.col > c1)
+            continue;
+        if (r.col >= c0 && r.col + r.cols - 1 <= c1 && r.row >= 0 && r.row + r.rows <= m_rows)
+            members << i;
+        else
+            setUsed(r);
+    }
+    std::sort(members.begin(), members.end(), [this](int a, int b) {
+        const TileRect &ra = m_rects[a], &rb = m_rects[b];
+        return ra.row != rb.row ? ra.row < rb.row : ra.col < rb.col;
+    });
+
+    const auto freeAt = [&](const TileRect &r) {
+        for (int y = r.row; y < r.row + r.rows; ++y)
+            for (int x = r.col; x < r.col + r.cols; ++x)
+                if (used[size_t(y) * width + size_t(x - c0)])
+                    return false;
+        return true;
+    };
+
+    QList<std::pair<int, QPoint>> moves;
+    for (int i : members) {
+        TileRect r = m_rects[i];
+        for (int row = 0; row <= r.row; ++row) {
+            const TileRect candidate{r.col, row, r.cols, r.rows};
+            if (freeAt(candidate)) {
+                r = candidate;
+                break;
+            }
+        }
+        setUsed(r);
+        if (r.row != m_rects[i].row)
+            moves.append({i, QPoint(r.col, r.row)});
+    }
+    return moves;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QList>
+#include <QPoint>
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+// ----------------------------
+// TileRect
+// ----------------------------
+// A tile's cells: top-left column / row and its span, in grid cells
+struct TileRect {
+    int col = 0;
+    int row = 0;
+    int cols = 0;
+    int rows = 0;
+
+    bool isNull() const { return cols <= 0 || rows <= 0; }
+    bool contains(int c, int r) const {
+        return c >= col && c < col + cols && r >= row && r < row + rows;
+    }
+};
+
+// ----------------------------
+// TileGrid
+// ----------------------------
+// Occupancy of the Start screen's cell grid, indexed by tile (the
+// TileModel row). Each cell keeps how many tiles cover it and the last
+// one placed there, so "is this free", slot searches and the walk towards
+// a neighbour touch only the cells involved instead of every tile.
+//
+// Cells outside the grid are ignored, as tiles are clipped by the
+// surface; overlapping tiles (older layouts) are counted, not rejected.
+class TileGrid {
+public:
+    void reset(int columns, int rows);
+    int columns() const { return m_columns; }
+    int rows() const { return m_rows; }
+
+    // Tile `tile` covers `rect`; replaces any earlier rect of the tile
+    void place(int tile, const TileRect &rect);
+    void remove(int tile);
+    void clear();
+
+    TileRect rect(int tile) const;
+
+    // Tiles covering a cell of columns [first, last], in tile order; reads
+    // only the cells of those columns
+    QList<int> tilesInColumns(int first, int last) const;
+
+    // `exclude` is a tile treated as absent (the one being dragged)
+    bool isFree(int col, int row, int exclude = -1) const;
+    bool fits(const TileRect &rect, int exclude = -1) const;
+
+    // Top-left cell for `rect`'s span at or near its position, closest
+    // first (Manhattan, up to `maxSteps` cells away)
+    std::optional<QPoint> nearestFree(const TileRect &rect, int maxSteps, int exclude = -1) const;
+
+    // First free cell for a `cols` x `rows` tile, top to bottom, then
+    // left to right
+    std::optional<QPoint> firstFree(int cols, int rows) const;
+
+    // Closest tile whose centre is in direction (dx, dy); tiles sharing a
+    // row (or column) band come first. -1 when there is none.
+    int neighbour(int tile, int dx, int dy) const;
+
+    // New top-left cells that close the vertical gaps in the column group
+    // (run of non-empty columns) around `tile`. Tiles keep their columns
+    // and their order from the top.
+    QList<std::pair<int, QPoint>> compactGroup(int tile) const;
+
+private:
+    int m_columns = 0;
+    int m_rows = 0;
+    std::vector<int> m_owner;              // last tile placed on the cell, or -1
+    std::vector<quint16> m_count;          // tiles covering the cell
+    QList<TileRect> m_rects;               // by tile; null when not placed
+
+    int cellAt(int col, int row) const { return row * m_columns + col; }
+    bool inGrid(int col, int row) const {
+        return col >= 0 && row >= 0 && col < m_columns && row < m_rows;
+    }
+    void mark(const TileRect &rect, int tile, int delta);
+    bool columnEmpty(int col) const;
+};
@@ -0,0 +1,316 @@
+#include "tilestore.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QTimer>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// -----------------------------
+// On-disk layout (native endian, local state only)
+// -----------------------------
+namespace {
+
+constexpr char Magic[8] = {'W', '8', 'T', 'I', 'L', 'E', 'S', '\0'};
+
+struct StoreHeader {
+    char magic[8];
+    quint32 version;
+    quint32 count;
+    quint32 recordsOffset;
+    quint32 stringsOffset;
+    quint32 stringsSize;       // UTF-16 code units
+    quint32 reserved;
+};
+
+struct StrRef {
+    quint32 offset;            // into the string table, in code units
+    quint32 length;
+};
+
+enum RecordFlags : quint32 {
+    TerminalFlag   = 1u << 0,
+    QmlEnabledFlag = 1u << 1
+};
+
+struct TileRecord {
+    double modelX;
+    double modelY;
+    StrRef name;
+    StrRef icon;
+    StrRef desktopFile;
+    StrRef command;
+    StrRef size;
+    StrRef color;
+    StrRef qmlPath;
+    quint32 flags;
+    quint32 reserved;
+};
+
+static_assert(sizeof(StoreHeader) == 32, "tile store header layout changed");
+static_assert(sizeof(TileRecord) == 80, "tile store record layout changed");
+
+// Lowest modelX first, then lowest modelY
+void sortTiles(QList<Tile> *tiles) {
+    std::sort(tiles->begin(), tiles->end(), [](const Tile &a, const Tile &b) {
+        if (!qFuzzyCompare(a.modelX, b.modelX))
+            return a.modelX < b.modelX;
+        return a.modelY < b.modelY;
+    });
+}
+
+QByteArray toBinary(QList<Tile> tiles) {
+    sortTiles(&tiles);
+
+    // Sizes, colours and tile directories repeat; store each once
+    QString table;
+    QHash<QString, StrRef> interned;
+    auto intern = [&](const QString &s) -> StrRef {
+        if (s.isEmpty())
+            return {0, 0};
+        auto it = interned.constFind(s);
+        if (it != interned.constEnd())
+            return *it;
+        StrRef ref{quint32(table.size()), quint32(s.size())};
+        table.append(s);
+        interned.insert(s, ref);
+        return ref;
+    };
+
+    std::vector<TileRecord> records;
+    records.reserve(size_t(tiles.size()));
+    for (const Tile &t : tiles) {
+        TileRecord r{};
+        r.modelX = t.modelX;
+        r.modelY = t.modelY;
+        r.name = intern(t.name);
+        r.icon = intern(t.icon);
+        r.desktopFile = intern(t.desktopFile);
+        r.command = intern(t.command);
+        r.size = intern(t.size);
+        r.color = intern(t.color);
+        r.qmlPath = intern(t.qmlPath);
+        r.flags = (t.terminal ? TerminalFlag : 0) | (t.qmlEnabled ? QmlEnabledFlag : 0);
+        records.push_back(r);
+    }
+
+    StoreHeader h{};
+    std::memcpy(h.magic, Magic, sizeof(Magic));
+    h.version = TileStore::Version;
+    h.count = quint32(records.size());
+    h.recordsOffset = sizeof(StoreHeader);
+    h.stringsOffset = quint32(sizeof(StoreHeader) + records.size() * sizeof(TileRecord));
+    h.stringsSize = quint32(table.size());
+
+    QByteArray bytes;
+    bytes.reserve(qsizetype(h.stringsOffset + h.stringsSize * sizeof(char16_t)));
+    bytes.append(reinterpret_cast<const char *>(&h), sizeof(h));
+    bytes.append(reinterpret_cast<const char *>(records.data()),
+                 qsizetype(records.size() * sizeof(TileRecord)));
+    bytes.append(reinterpret_cast<const char *>(table.utf16()),
+                 table.size() * qsizetype(sizeof(char16_t)));
+    return bytes;
+}
+
+// False when the data is corrupt or from another version
+bool fromBinary(const uchar *base, qint64 size, QList<Tile> *tiles) {
+    if (size < qint64(sizeof(StoreHeader)))
+        return false;
+
+    StoreHeader h;
+    std::memcpy(&h, base, sizeof(h));
+    const quint64 recordsEnd = quint64(h.recordsOffset) + quint64(h.count) * sizeof(TileRecord);
+    const quint64 stringsEnd = quint64(h.stringsOffset) + quint64(h.stringsSize) * sizeof(char16_t);
+
+    const bool valid = std::memcmp(h.magic, Magic, sizeof(Magic)) == 0
+                       && h.version == TileStore::Version
+                       && h.recordsOffset % alignof(TileRecord) == 0
+                       && h.stringsOffset % alignof(char16_t) == 0
+                       && recordsEnd <= quint64(size)
+                       && stringsEnd <= quint64(size);
+    if (!valid)
+        return false;
+
+    const auto *records = reinterpret_cast<const TileRecord *>(base + h.recordsOffset);
+    const auto *strings = reinterpret_cast<const QChar *>(base + h.stringsOffset);
+    bool inBounds = true;
+
+    auto str = [&](const StrRef &ref) -> QString {
+        if (quint64(ref.offset) + ref.length > h.stringsSize) {
+            inBounds = false;
+            return QString();
+        }
+        return QString(strings + ref.offset, ref.length);
+    };
+
+    QList<Tile> result;
+    result.reserve(h.count);
+    for (quint32 i = 0; i < h.count && inBounds; ++i) {
+        const TileRecord &r = records[i];
+        Tile t;
+        t.name = str(r.name);
+        t.icon = str(r.icon);
+        t.desktopFile = str(r.desktopFile);
+        t.command = str(r.command);
+        t.modelX = r.modelX;
+        t.modelY = r.modelY;
+        t.size = str(r.size);
+        t.color = str(r.color);
+        t.qmlPath = str(r.qmlPath);
+        t.terminal = r.flags & TerminalFlag;
+        t.qmlEnabled = r.flags & QmlEnabledFlag;
+        if (t.size.isEmpty())
+            t.size = "medium";
+        result.append(std::move(t));
+    }
+    if (!inBounds)
+        return false;
+
+    *tiles = std::move(result);
+    return true;
+}
+
+// launcher_tiles.json from before the binary store
+QList<Tile> fromJson(const QByteArray &data) {
+    QList<Tile> tiles;
+    const QJsonArray arr = QJsonDocument::fromJson(data).array();
+    for (const auto &v : arr) {
+        const QJsonObject o = v.toObject();
+        Tile t;
+        t.name        = o["name"].toString();
+        t.icon        = o["icon"].toString();
+        t.desktopFile = o["desktopFile"].toString();
+        t.command     = o["command"].toString();
+        t.modelX      = o["modelX"].toDouble();
+        t.modelY      = o["modelY"].toDouble();
+        t.size        = o["size"].toString("medium");
+        t.terminal    = o.value("terminal").toBool(false);
+        t.color       = o.value("color").toString("");
+        t.qmlPath     = o.value("qmlPath").toString("");
+        t.qmlEnabled  = o.value("qmlEnabled").toBool(false);
+        tiles.append(t);
+    }
+    return tiles;
+}
+
+// Temporary file, fsync, rename, then the directory, so the new layout
+// survives a power cut
+bool writeFile(const QString &path, const QByteArray &bytes) {
+    const QString dir = QFileInfo(path).absolutePath();
+    QDir().mkpath(dir);
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(bytes) != bytes.size() || !file.commit()) {
+        qWarning() << "⚠️ Could not save the tile layout:" << path << file.errorString();
+        return false;
+    }
+
+    const int fd = open(QFile::encodeName(dir).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+    return true;
+}
+
+} // namespace
+
+// -----------------------------
+// Constructor / Destructor
+// -----------------------------
+TileStore::TileStore(const QString &path, const QString &legacyJsonPath, QObject *parent)
+: QObject(parent)
+, m_path(path)
+, m_legacyJsonPath(legacyJsonPath) {
+    m_io.setMaxThreadCount(1);
+
+    m_timer = new QTimer(this);
+    m_timer->setSingleShot(true);
+    m_timer->setInterval(SaveDelayMs);
+    connect(m_timer, &QTimer::timeout, this, &TileStore::write);
+}
+
+TileStore::~TileStore() {
+    flush();
+}
+
+// -----------------------------
+// Load / save
+// -----------------------------
+QList<Tile> TileStore::load() {
+    QList<Tile> tiles;
+
+    QFile file(m_path);
+    if (file.open(QIODevice::ReadOnly)) {
+        const qint64 size = file.size();
+        uchar *base = size > 0 ? file.map(0, size) : nullptr;
+        const bool ok = base && fromBinary(base, size, &tiles);
+        if (base)
+            file.unmap(base);
+        if (ok)
+            return tiles;
+        qWarning() << "⚠️ Ignoring unreadable tile layout:" << m_path;
+    }
+
+    // One-time migration; the JSON is kept aside, not read again
+    QFile json(m_legacyJsonPath);
+    if (m_legacyJsonPath.isEmpty() || !json.open(QIODevice::ReadOnly))
+        return tiles;
+
+    tiles = fromJson(json.readAll());
+    json.close();
+
+    QByteArray bytes = toBinary(tiles);
+    if (writeFile(m_path, bytes)) {
+        QFile::remove(m_legacyJsonPath + ".bak");
+        QFile::rename(m_legacyJsonPath, m_legacyJsonPath + ".bak");
+        m_written = std::move(bytes);
+        qDebug() << "✅ Migrated" << tiles.size() << "tiles to" << m_path;
+    }
+
+    // Binary order, so indexes match the next load
+    sortTiles(&tiles);
+    return tiles;
+}
+
+void TileStore::save(const QList<Tile> &tiles) {
+    m_pending = tiles;
+    m_dirty = true;
+    if (!m_timer->isActive())
+        m_timer->start();
+}
+
+void TileStore::flush() {
+    m_timer->stop();
+    write();
+    m_io.waitForDone();
+}
+
+// Serializes and writes on the pool; the layout is an implicitly shared
+// copy, so nothing is copied on this thread
+void TileStore::write() {
+    if (!m_dirty)
+        return;
+    m_dirty = false;
+
+    m_io.start([this, tiles = std::exchange(m_pending, {})]() {
+        QByteArray bytes = toBinary(tiles);
+        if (bytes == m_written)
+            return;
+        if (writeFile(m_path, bytes))
+            m_written = std::move(bytes);
+    });
+}
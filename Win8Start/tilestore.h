@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QMetaType>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+
+class QTimer;
+
+// ----------------------------
+// Tile
+// ----------------------------
+struct Tile {
+    QString name;
+    QString icon;
+    QString desktopFile;
+    QString command;
+    bool terminal = false;
+    double modelX;
+    double modelY;
+    QString size;
+    QString color;
+    QString qmlPath;   // external tile UI (optional)
+    bool qmlEnabled = false;
+    int qmlGeneration = 0;
+};
+
+Q_DECLARE_METATYPE(Tile)
+
+// ----------------------------
+// TileStore
+// ----------------------------
+// The pinned tile layout on disk: a versioned binary file with one fixed
+// record per tile and a deduplicated UTF-16 string table, like AppCache.
+// It is small enough (a few KiB for hundreds of tiles) to be mapped and
+// read on the GUI thread before the first frame.
+//
+// save() only keeps the latest layout; it is written SaveDelayMs after
+// the first change, so a drag session or a run of edits costs one write.
+// Writes go through QSaveFile (temporary file, fsync, rename) on a private
+// single-thread pool, so a crash leaves either the old layout or the new
+// one, never half of each.
+class TileStore : public QObject {
+    Q_OBJECT
+public:
+    static constexpr quint32 Version = 1;
+    static constexpr int SaveDelayMs = 500;
+
+    // `legacyJsonPath` is the JSON layout of earlier versions, migrated
+    // (and renamed to .bak) when there is no binary layout yet
+    explicit TileStore(const QString &path, const QString &legacyJsonPath = QString(),
+                       QObject *parent = nullptr);
+    ~TileStore() override;    // flushes
+
+    QList<Tile> load();
+
+    void save(const QList<Tile> &tiles);
+
+    // Write a pending layout now and wait for the disk
+    void flush();
+
+private:
+    QString m_path;
+    QString m_legacyJsonPath;
+    QList<Tile> m_pending;
+    bool m_dirty = false;
+    QTimer *m_timer = nullptr;
+    QThreadPool m_io;
+    QByteArray m_written;      // last bytes on disk; load(), then the worker
+
+    void write();
+};
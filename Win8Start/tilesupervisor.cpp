@@ -0,0 +1,158 @@
+#include "tilesupervisor.h"
+
+#include <QDebug>
+#include <QFileInfo>
+#include <QTimer>
+
+#include <csignal>
+
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+// -----------------------------
+// Constructor / Destructor
+// -----------------------------
+TileSupervisor::TileSupervisor(QObject *parent)
+: QObject(parent) {}
+
+TileSupervisor::~TileSupervisor() {
+    for (Script &s : m_scripts) {
+        if (!s.process)
+            continue;
+        s.process->disconnect(this);
+        signalGroup(s.process, SIGKILL);
+        signalGroup(s.process, SIGCONT);
+        s.process->waitForFinished(KillGraceMs);
+    }
+}
+
+// -----------------------------
+// Scripts
+// -----------------------------
+void TileSupervisor::sync(const QHash<QString, QString> &scripts) {
+    for (auto it = m_scripts.begin(); it != m_scripts.end();) {
+        if (scripts.contains(it.key())) {
+            ++it;
+            continue;
+        }
+        qDebug() << "🛑 Stopping live tile logic:" << it.key();
+        if (it->process)
+            terminate(it->process);
+        delete it->restart;
+        it = m_scripts.erase(it);
+    }
+
+    for (auto it = scripts.cbegin(); it != scripts.cend(); ++it) {
+        const QString path = it.key();
+        if (m_scripts.contains(path))
+            continue;
+
+        Script &s = m_scripts[path];
+        s.socket = it.value();
+        s.restart = new QTimer(this);
+        s.restart->setSingleShot(true);
+        connect(s.restart, &QTimer::timeout, this, [this, path]() { start(path); });
+        start(path);
+    }
+}
+
+void TileSupervisor::setPaused(bool paused) {
+    if (m_paused == paused)
+        return;
+    m_paused = paused;
+
+    for (auto it = m_scripts.begin(); it != m_scripts.end(); ++it) {
+        if (it->process)
+            signalGroup(it->process, paused ? SIGSTOP : SIGCONT);
+        else if (!paused && !it->done && !it->restart->isActive())
+            start(it.key());     // came due while paused
+    }
+}
+
+void TileSupervisor::start(const QString &path) {
+    auto it = m_scripts.find(path);
+    if (it == m_scripts.end() || it->process || it->done || m_paused)
+        return;
+
+    qDebug() << "⚡ logic.py running:" << path;
+
+    QProcess *p = new QProcess(this);
+    p->setProgram("python3");
+    p->setArguments({ path });
+    p->setWorkingDirectory(QFileInfo(path).absolutePath());
+    p->setProcessChannelMode(QProcess::ForwardedChannels);
+
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    env.insert("WIN8START_TILE_SOCKET", it->socket);
+    p->setProcessEnvironment(env);
+
+    // In the child, before exec; async-signal-safe calls only
+    p->setChildProcessModifier([]() {
+        setpgid(0, 0);
+        prctl(PR_SET_PDEATHSIG, SIGTERM);
+        setpriority(PRIO_PROCESS, 0, NiceLevel);
+
+        const rlimit memory{ MemoryLimitBytes, MemoryLimitBytes };
+        setrlimit(RLIMIT_AS, &memory);
+        const rlimit cpu{ CpuLimitSeconds, CpuLimitSeconds + 5 };
+        setrlimit(RLIMIT_CPU, &cpu);
+    });
+
+    connect(p, &QProcess::finished, this, [this, path, p](int code, QProcess::ExitStatus status) {
+        exited(path, p, status == QProcess::NormalExit && code == 0);
+    });
+    connect(p, &QProcess::errorOccurred, this, [this, path, p](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart)
+            exited(path, p, false);
+    });
+
+    it->process = p;
+    it->uptime.start();
+    p->start();
+}
+
+void TileSupervisor::exited(const QString &path, QProcess *process, bool clean) {
+    process->deleteLater();
+
+    auto it = m_scripts.find(path);
+    if (it == m_scripts.end() || it->process != process)
+        return;
+    it->process = nullptr;
+
+    if (clean) {
+        qDebug() << "✅ logic.py finished:" << path;
+        it->done = true;
+        return;
+    }
+
+    if (it->uptime.elapsed() >= StableAfterMs)
+        it->backoffMs = MinBackoffMs;
+
+    qWarning() << "⚠️ logic.py died:" << path << process->errorString()
+               << "→ restarting in" << it->backoffMs << "ms";
+    it->restart->start(it->backoffMs);
+    it->backoffMs = qMin(it->backoffMs * 2, MaxBackoffMs);
+}
+
+// SIGTERM to the group (continued, in case it is stopped), SIGKILL for
+// whatever is left after KillGraceMs; the process object goes away once
+// the script is reaped
+void TileSupervisor::terminate(QProcess *process) {
+    process->disconnect(this);
+    if (process->state() == QProcess::NotRunning) {
+        process->deleteLater();
+        return;
+    }
+
+    signalGroup(process, SIGTERM);
+    signalGroup(process, SIGCONT);
+    connect(process, &QProcess::finished, process, &QObject::deleteLater);
+    QTimer::singleShot(KillGraceMs, process, [process]() { signalGroup(process, SIGKILL); });
+}
+
+void TileSupervisor::signalGroup(QProcess *process, int sig) {
+    const qint64 pid = process->processId();
+    if (pid > 0)
+        ::kill(-pid_t(pid), sig);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QProcess>
+#include <QString>
+
+class QTimer;
+
+// ----------------------------
+// TileSupervisor
+// ----------------------------
+// Owns the logic.py helpers of live tiles, one process per script.
+//
+// sync() is given every script the pinned, enabled live tiles need: new
+// ones are started, ones no longer listed (tile unpinned or live tile
+// disabled) are killed. A script finds its tile's LiveTileBus socket in
+// $WIN8START_TILE_SOCKET. Each script leads its own process group, so the
+// SIGSTOP / SIGCONT of setPaused() also reach whatever it spawns, and a
+// hidden Start menu costs no CPU and no wake-ups.
+//
+// Scripts run niced, under an address space limit and a CPU time limit
+// (a runaway loop gets SIGXCPU). One that crashes or hits a limit is
+// started again after a delay that doubles from MinBackoffMs up to
+// MaxBackoffMs, and drops back once it has run for StableAfterMs. A
+// script that exits with 0 is done and stays stopped.
+class TileSupervisor : public QObject {
+    Q_OBJECT
+public:
+    static constexpr int NiceLevel = 10;
+    static constexpr quint64 MemoryLimitBytes = 512ull * 1024 * 1024;   // RLIMIT_AS
+    static constexpr quint64 CpuLimitSeconds = 10 * 60;                 // RLIMIT_CPU
+    static constexpr int MinBackoffMs = 1000;
+    static constexpr int MaxBackoffMs = 5 * 60 * 1000;
+    static constexpr int StableAfterMs = 60 * 1000;
+    static constexpr int KillGraceMs = 2000;       // SIGTERM, then SIGKILL
+
+    explicit TileSupervisor(QObject *parent = nullptr);
+    ~TileSupervisor() override;     // kills every script
+
+    // Run exactly `scripts`: absolute logic.py path -> bus socket
+    void sync(const QHash<QString, QString> &scripts);
+
+    // While paused nothing is started and running scripts are stopped
+    void setPaused(bool paused);
+    bool isPaused() const { return m_paused; }
+
+private:
+    struct Script {
+        QString socket;
+        QProcess *process = nullptr;
+        QTimer *restart = nullptr;
+        QElapsedTimer uptime;
+        int backoffMs = MinBackoffMs;
+        bool done = false;          // exited cleanly
+    };
+
+    QHash<QString, Script> m_scripts;
+    bool m_paused = false;
+
+    void start(const QString &path);
+    void exited(const QString &path, QProcess *process, bool clean);
+    void terminate(QProcess *process);
+    static void signalGroup(QProcess *process, int sig);
+};
@@ -125,6 +125,32 @@ void WindowWatcher::handleTitle(
     emit self->windowAdded(info.title);
 }
 
+void WindowWatcher::handleAppId(
+    void *data,
+    zwlr_foreign_toplevel_handle_v1 *handle,
+    const char *appId)
+{
+    auto *self = static_cast<WindowWatcher*>(data);
+    if (!appId) return;
+    
+    self->windows[handle].appId = QString::fromUtf8(appId);
+}
+
+void WindowWatcher::handleDone(
+    void *data,
+    zwlr_foreign_toplevel_handle_v1 *handle)
+{
+    auto *self = static_cast<WindowWatcher*>(data);
+    
+    auto it = self->windows.find(handle);
+    if (it == self->windows.end() || it->ready || it->appId.isEmpty())
+        return;
+    
+    // 🔔 All initial state applied; the app_id is final
+    it->ready = true;
+    emit self->toplevelReady(it->appId, it->title);
+}
+
 void WindowWatcher::handleClosed(
     void *data,
     zwlr_foreign_toplevel_handle_v1 *handle)
@@ -13,6 +13,8 @@ extern "C" {
 // Structure to hold window info
 struct WindowInfo {
     QString title;
+    QString appId;
+    bool ready = false;     // first done event seen
 };
 
 class WindowWatcher : public QObject {
@@ -26,6 +28,8 @@ public:
 signals:
     void windowAdded(const QString &title);
     void windowRemoved(const QString &title);
+    // Once per toplevel, at its first done event with an app_id
+    void toplevelReady(const QString &appId, const QString &title);
     
 private:
     wl_display *display = nullptr;
@@ -38,11 +42,11 @@ private:
     // Wayland handlers
     // -----------------------------
     static void handleTitle(void *data, zwlr_foreign_toplevel_handle_v1 *handle, const char *title);
-    static void handleAppId(void *, zwlr_foreign_toplevel_handle_v1 *, const char *) {}
+    static void handleAppId(void *data, zwlr_foreign_toplevel_handle_v1 *handle, const char *appId);
     static void handleOutputEnter(void *, zwlr_foreign_toplevel_handle_v1 *, wl_output *) {}
     static void handleOutputLeave(void *, zwlr_foreign_toplevel_handle_v1 *, wl_output *) {}
     static void handleState(void *, zwlr_foreign_toplevel_handle_v1 *, wl_array *) {}
-    static void handleDone(void *, zwlr_foreign_toplevel_handle_v1 *) {}
+    static void handleDone(void *data, zwlr_foreign_toplevel_handle_v1 *handle);
     static void handleClosed(void *data, zwlr_foreign_toplevel_handle_v1 *handle);
     static void handleParent(void *, zwlr_foreign_toplevel_handle_v1 *, zwlr_foreign_toplevel_handle_v1 *) {}
     
@@ -0,0 +1,464 @@
+#include "icontheme.h"
+#include "xdgdatadirs.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSet>
+#include <QStandardPaths>
+
+#include <climits>
+
+namespace {
+
+constexpr quint32 CacheMagic = 0x57384954;   // "W8IT"
+constexpr quint32 CacheVersion = 2;   // 2: flatpak and snap exports
+
+using IniGroups = QHash<QString, QHash<QString, QString>>;
+
+// index.theme, kdeglobals and gtk settings.ini are all simple key files;
+// QSettings would treat '/' in group names and ',' in values specially.
+IniGroups readIni(const QString &path) {
+    IniGroups groups;
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly | QIODevice::Text))
+        return groups;
+
+    QString group;
+    while (!f.atEnd()) {
+        const QString line = QString::fromUtf8(f.readLine()).trimmed();
+        if (line.isEmpty() || line.startsWith('#'))
+            continue;
+
+        if (line.startsWith('[') && line.endsWith(']')) {
+            group = line.mid(1, line.size() - 2);
+            continue;
+        }
+
+        const int eq = line.indexOf('=');
+        if (eq <= 0)
+            continue;
+        groups[group].insert(line.left(eq).trimmed(), line.mid(eq + 1).trimmed());
+    }
+    return groups;
+}
+
+QStringList splitList(const QString &value) {
+    QStringList out;
+    for (const QString &part : value.split(',', Qt::SkipEmptyParts)) {
+        const QString t = part.trimmed();
+        if (!t.isEmpty())
+            out.append(t);
+    }
+    return out;
+}
+
+// png beats svg beats xpm inside one directory
+int extensionRank(const QString &suffix) {
+    if (suffix == QLatin1String("png")) return 0;
+    if (suffix == QLatin1String("svg")) return 1;
+    if (suffix == QLatin1String("xpm")) return 2;
+    return -1;
+}
+
+QString stripIconExtension(const QString &name) {
+    const int dot = name.lastIndexOf('.');
+    if (dot > 0 && extensionRank(name.mid(dot + 1)) >= 0)
+        return name.left(dot);
+    return name;
+}
+
+} // namespace
+
+// -----------------------------
+// Singleton
+// -----------------------------
+IconTheme &IconTheme::instance() {
+    static IconTheme theme;
+    return theme;
+}
+
+IconTheme::IconTheme() {
+    const QStringList chain = resolveChain();
+    if (!loadCache(chain)) {
+        build(chain);
+        saveCache();
+    }
+}
+
+QStringList IconTheme::themeChain() const {
+    QReadLocker locker(&m_lock);
+    return m_chain;
+}
+
+// -----------------------------
+// Lookup (no filesystem access)
+// -----------------------------
+QString IconTheme::lookup(const QString &name, int size) const {
+    if (name.isEmpty())
+        return QString();
+
+    if (name.startsWith('/'))
+        return name;
+
+    const QString key = stripIconExtension(name);
+
+    QReadLocker locker(&m_lock);
+
+    for (const Theme &theme : m_themes) {
+        auto it = theme.icons.constFind(key);
+        if (it == theme.icons.constEnd())
+            continue;
+
+        // XDG lookup: first exact size match in Directories order,
+        // otherwise the directory with the smallest size distance
+        const QString *closest = nullptr;
+        int minimal = INT_MAX;
+
+        for (const IconFile &file : *it) {
+            const IconDir &dir = theme.dirs[file.dir];
+            if (matchesSize(dir, size))
+                return file.path;
+
+            const int distance = sizeDistance(dir, size);
+            if (distance < minimal) {
+                minimal = distance;
+                closest = &file.path;
+            }
+        }
+
+        if (closest)
+            return *closest;
+    }
+
+    return m_pixmaps.value(key);
+}
+
+bool IconTheme::matchesSize(const IconDir &dir, int size) {
+    if (dir.scale != 1)
+        return false;
+    switch (dir.type) {
+        case Fixed:     return dir.size == size;
+        case Scalable:  return dir.minSize <= size && size <= dir.maxSize;
+        case Threshold: return dir.size - dir.threshold <= size && size <= dir.size + dir.threshold;
+    }
+    return false;
+}
+
+int IconTheme::sizeDistance(const IconDir &dir, int size) {
+    const int s = dir.size * dir.scale;
+    switch (dir.type) {
+        case Fixed:
+            return qAbs(s - size);
+        case Scalable:
+            if (size < dir.minSize * dir.scale) return dir.minSize * dir.scale - size;
+            if (size > dir.maxSize * dir.scale) return size - dir.maxSize * dir.scale;
+            return 0;
+        case Threshold:
+            if (size < (dir.size - dir.threshold) * dir.scale) return (dir.size - dir.threshold) * dir.scale - size;
+            if (size > (dir.size + dir.threshold) * dir.scale) return size - (dir.size + dir.threshold) * dir.scale;
+            return 0;
+    }
+    return INT_MAX;
+}
+
+// -----------------------------
+// Theme selection
+// -----------------------------
+// The same data directories as the applications, so icons exported by
+// flatpak and snap are found
+QStringList IconTheme::baseDirs() {
+    QStringList dirs;
+    dirs << QDir::homePath() + "/.icons";
+    for (const QString &dataDir : xdgDataDirs())
+        dirs << dataDir + "/icons";
+    return dirs;
+}
+
+QString IconTheme::userThemeName() {
+    const QString override = qEnvironmentVariable("WIN8_ICON_THEME");
+    if (!override.isEmpty())
+        return override;
+
+    const QString config = QStandardPaths::writableLocation(QStandardPaths::GenericConfigLocation);
+
+    // KDE / Qt desktops
+    QString name = readIni(config + "/kdeglobals").value("Icons").value("Theme");
+    if (!name.isEmpty())
+        return name;
+
+    // GTK desktops
+    name = readIni(config + "/gtk-3.0/settings.ini").value("Settings").value("gtk-icon-theme-name");
+    if (!name.isEmpty())
+        return name;
+
+    return "hicolor";
+}
+
+QStringList IconTheme::resolveChain() const {
+    const QStringList bases = baseDirs();
+    QStringList chain;
+    QStringList queue{userThemeName()};
+
+    // Breadth-first over Inherits=, each theme once
+    while (!queue.isEmpty()) {
+        const QString theme = queue.takeFirst();
+        if (chain.contains(theme))
+            continue;
+        chain << theme;
+
+        for (const QString &base : bases) {
+            const QString index = base + "/" + theme + "/index.theme";
+            if (!QFile::exists(index))
+                continue;
+            queue << splitList(readIni(index).value("Icon Theme").value("Inherits"));
+            break;
+        }
+    }
+
+    // hicolor is the mandatory fallback; breeze kept for the icons the old
+    // resolvers found there
+    chain.removeAll("hicolor");
+    chain << "hicolor";
+    if (!chain.contains("breeze"))
+        chain << "breeze";
+    return chain;
+}
+
+// -----------------------------
+// Scan
+// -----------------------------
+void IconTheme::build(const QStringList &chain) {
+    const QStringList bases = baseDirs();
+    QList<Theme> themes;
+    QHash<QString, QString> pixmaps;
+    QList<QPair<QString, qint64>> stamps;
+
+    for (const QString &base : bases)
+        stamps.append({base, mtimeOf(base)});
+
+    for (const QString &themeName : chain) {
+        Theme theme;
+        theme.name = themeName;
+
+        // index.theme comes from the first base dir that has one
+        IniGroups index;
+        for (const QString &base : bases) {
+            const QString path = base + "/" + themeName + "/index.theme";
+            if (QFile::exists(path)) {
+                index = readIni(path);
+                break;
+            }
+        }
+        if (index.isEmpty())
+            continue;
+
+        QStringList subdirs = splitList(index.value("Icon Theme").value("Directories"));
+        subdirs << splitList(index.value("Icon Theme").value("ScaledDirectories"));
+        subdirs.removeDuplicates();
+
+        for (const QString &subdir : subdirs) {
+            const QHash<QString, QString> keys = index.value(subdir);
+
+            IconDir dir;
+            dir.size = keys.value("Size").toInt();
+            dir.scale = qMax(1, keys.value("Scale", "1").toInt());
+            dir.minSize = keys.value("MinSize", QString::number(dir.size)).toInt();
+            dir.maxSize = keys.value("MaxSize", QString::number(dir.size)).toInt();
+            dir.threshold = keys.value("Threshold", "2").toInt();
+
+            const QString type = keys.value("Type", "Threshold");
+            dir.type = type == "Fixed" ? Fixed : type == "Scalable" ? Scalable : Threshold;
+
+            const int dirIndex = theme.dirs.size();
+            theme.dirs.append(dir);
+
+            for (const QString &base : bases) {
+                const QString path = base + "/" + themeName + "/" + subdir;
+                const qint64 mtime = mtimeOf(path);
+                stamps.append({path, mtime});
+                if (mtime < 0)
+                    continue;
+
+                // name -> (rank, path), keeping the preferred extension
+                QHash<QString, QPair<int, QString>> best;
+                const QFileInfoList files = QDir(path).entryInfoList(QDir::Files);
+                for (const QFileInfo &fi : files) {
+                    const int rank = extensionRank(fi.suffix());
+                    if (rank < 0)
+                        continue;
+                    auto it = best.find(fi.completeBaseName());
+                    if (it == best.end() || rank < it->first)
+                        best.insert(fi.completeBaseName(), {rank, fi.absoluteFilePath()});
+                }
+
+                for (auto it = best.cbegin(); it != best.cend(); ++it)
+                    theme.icons[it.key()].append({dirIndex, it->second});
+            }
+        }
+
+        for (const QString &base : bases)
+            stamps.append({base + "/" + themeName, mtimeOf(base + "/" + themeName)});
+
+        themes.append(theme);
+    }
+
+    const QString pixmapDir = "/usr/share/pixmaps";
+    stamps.append({pixmapDir, mtimeOf(pixmapDir)});
+    QHash<QString, int> pixmapRank;
+    for (const QFileInfo &fi : QDir(pixmapDir).entryInfoList(QDir::Files)) {
+        const int rank = extensionRank(fi.suffix());
+        if (rank < 0)
+            continue;
+        const QString name = fi.completeBaseName();
+        if (!pixmapRank.contains(name) || rank < pixmapRank.value(name)) {
+            pixmapRank.insert(name, rank);
+            pixmaps.insert(name, fi.absoluteFilePath());
+        }
+    }
+
+    QWriteLocker locker(&m_lock);
+    m_chain = chain;
+    m_themes = std::move(themes);
+    m_pixmaps = std::move(pixmaps);
+    m_stamps = std::move(stamps);
+
+    qDebug() << "🎨 Icon theme index built:" << m_chain;
+}
+
+qint64 IconTheme::mtimeOf(const QString &path) {
+    QFileInfo fi(path);
+    return fi.exists() ? fi.lastModified().toMSecsSinceEpoch() : -1;
+}
+
+bool IconTheme::stampsValid() const {
+    for (const auto &stamp : m_stamps) {
+        if (mtimeOf(stamp.first) != stamp.second)
+            return false;
+    }
+    return true;
+}
+
+void IconTheme::revalidate() {
+    const QStringList chain = resolveChain();
+    {
+        QReadLocker locker(&m_lock);
+        if (chain == m_chain && stampsValid())
+            return;
+    }
+    build(chain);
+    saveCache();
+}
+
+// -----------------------------
+// Persistence
+// -----------------------------
+QString IconTheme::cachePath() {
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) +
+           "/Win8DE/icon-theme-index.bin";
+}
+
+bool IconTheme::loadCache(const QStringList &chain) {
+    QFile f(cachePath());
+    if (!f.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&f);
+    quint32 magic = 0, version = 0;
+    in >> magic >> version;
+    if (magic != CacheMagic || version != CacheVersion)
+        return false;
+
+    QStringList cachedChain;
+    QList<QPair<QString, qint64>> stamps;
+    in >> cachedChain >> stamps;
+    if (cachedChain != chain)
+        return false;
+
+    QList<Theme> themes;
+    qint32 themeCount = 0;
+    in >> themeCount;
+    for (qint32 t = 0; t < themeCount && in.status() == QDataStream::Ok; ++t) {
+        Theme theme;
+        qint32 dirCount = 0;
+        in >> theme.name >> dirCount;
+        for (qint32 d = 0; d < dirCount && in.status() == QDataStream::Ok; ++d) {
+            IconDir dir;
+            qint32 type = 0;
+            in >> dir.size >> dir.minSize >> dir.maxSize >> dir.threshold >> dir.scale >> type;
+            dir.type = DirType(type);
+            theme.dirs.append(dir);
+        }
+
+        qint32 nameCount = 0;
+        in >> nameCount;
+        theme.icons.reserve(nameCount);
+        for (qint32 n = 0; n < nameCount && in.status() == QDataStream::Ok; ++n) {
+            QString name;
+            qint32 fileCount = 0;
+            in >> name >> fileCount;
+            QList<IconFile> files;
+            files.reserve(fileCount);
+            for (qint32 i = 0; i < fileCount && in.status() == QDataStream::Ok; ++i) {
+                IconFile file;
+                in >> file.dir >> file.path;
+                if (file.dir < 0 || file.dir >= theme.dirs.size())
+                    return false;
+                files.append(file);
+            }
+            theme.icons.insert(name, files);
+        }
+        themes.append(theme);
+    }
+
+    QHash<QString, QString> pixmaps;
+    in >> pixmaps;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    QWriteLocker locker(&m_lock);
+    m_chain = cachedChain;
+    m_stamps = stamps;
+    if (!stampsValid())
+        return false;
+
+    m_themes = std::move(themes);
+    m_pixmaps = std::move(pixmaps);
+    return true;
+}
+
+void IconTheme::saveCache() const {
+    QReadLocker locker(&m_lock);
+
+    const QString path = cachePath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream out(&f);
+    out << CacheMagic << CacheVersion << m_chain << m_stamps;
+
+    out << qint32(m_themes.size());
+    for (const Theme &theme : m_themes) {
+        out << theme.name << qint32(theme.dirs.size());
+        for (const IconDir &dir : theme.dirs)
+            out << dir.size << dir.minSize << dir.maxSize << dir.threshold << dir.scale << qint32(dir.type);
+
+        out << qint32(theme.icons.size());
+        for (auto it = theme.icons.cbegin(); it != theme.icons.cend(); ++it) {
+            out << it.key() << qint32(it->size());
+            for (const IconFile &file : *it)
+                out << qint32(file.dir) << file.path;
+        }
+    }
+
+    out << m_pixmaps;
+
+    if (!f.commit())
+        qWarning() << "IconTheme: failed to write" << path;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QReadWriteLock>
+#include <QString>
+#include <QStringList>
+
+// ----------------------------
+// IconTheme
+// ----------------------------
+// In-memory index of the XDG icon themes (user theme, its Inherits= chain,
+// hicolor) plus /usr/share/pixmaps. The directories are scanned once, the
+// result is persisted keyed by directory mtimes, and lookups afterwards
+// are plain hash lookups without filesystem access.
+//
+// Shared by Win8Start and Win8Running; safe to use from any thread.
+class IconTheme {
+public:
+    static IconTheme &instance();
+
+    // Absolute path of the best match for `name` at `size` px, or an empty
+    // string. Absolute paths are returned unchanged.
+    QString lookup(const QString &name, int size = 256) const;
+
+    // Re-stat the indexed directories and rebuild if anything changed.
+    // Cheap enough to call after packages were installed.
+    void revalidate();
+
+    QStringList themeChain() const;
+
+private:
+    IconTheme();
+
+    enum DirType { Fixed, Scalable, Threshold };
+
+    struct IconDir {
+        int size = 0;
+        int minSize = 0;
+        int maxSize = 0;
+        int threshold = 2;
+        int scale = 1;
+        DirType type = Threshold;
+    };
+
+    struct IconFile {
+        int dir;          // index into Theme::dirs
+        QString path;
+    };
+
+    struct Theme {
+        QString name;
+        QList<IconDir> dirs;
+        QHash<QString, QList<IconFile>> icons;
+    };
+
+    mutable QReadWriteLock m_lock;
+    QStringList m_chain;
+    QList<Theme> m_themes;                      // in lookup order
+    QHash<QString, QString> m_pixmaps;          // name -> path
+    QList<QPair<QString, qint64>> m_stamps;     // directory -> mtime
+
+    static QStringList baseDirs();
+    static QString userThemeName();
+    static QString cachePath();
+    static qint64 mtimeOf(const QString &path);
+
+    QStringList resolveChain() const;
+    void build(const QStringList &chain);
+    bool loadCache(const QStringList &chain);
+    void saveCache() const;
+    bool stampsValid() const;
+
+    static bool matchesSize(const IconDir &dir, int size);
+    static int sizeDistance(const IconDir &dir, int size);
+};
@@ -0,0 +1,30 @@
+#include "xdgdatadirs.h"
+
+#include <QDir>
+#include <QStandardPaths>
+
+QStringList xdgDataDirs() {
+    QStringList out;
+    auto add = [&out](const QString &dataDir) {
+        if (dataDir.isEmpty())
+            return;
+        const QString dir = QDir::cleanPath(dataDir);
+        if (!out.contains(dir))
+            out.append(dir);
+    };
+
+    add(QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation));
+
+    QString dataDirs = qEnvironmentVariable("XDG_DATA_DIRS");
+    if (dataDirs.isEmpty())
+        dataDirs = "/usr/local/share:/usr/share";
+    for (const QString &dataDir : dataDirs.split(':', Qt::SkipEmptyParts))
+        add(dataDir);
+
+    // Not every session puts these on XDG_DATA_DIRS
+    add(QDir::homePath() + "/.local/share/flatpak/exports/share");
+    add("/var/lib/flatpak/exports/share");
+    add("/var/lib/snapd/desktop");
+    add("/usr/share");
+    return out;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <QStringList>
+
+// ----------------------------
+// xdgDataDirs
+// ----------------------------
+// $XDG_DATA_HOME, every $XDG_DATA_DIRS entry and the flatpak and snap
+// exports, highest priority first, without duplicates. Applications live
+// in <dir>/applications and icon themes in <dir>/icons, so AppIndex and
+// IconTheme both derive their directories from this list.
+//
+// Shared by Win8Start and Win8Running.
+QStringList xdgDataDirs();
@@ -1,12 +1,85 @@
+import json
 import os
+import signal
+import socket
+import struct
 import subprocess
+import sys
 import requests
 import time
+from multiprocessing import shared_memory
 from urllib.parse import unquote
 
 THUMBNAIL_FILE = "art.jpg"
 UPDATE_INTERVAL = 10  # seconds between checks
 
+# Message kinds of the Win8Start live tile bus
+MSG_JSON = 1
+MSG_IMAGE = 3
+
+
+class LiveTile:
+    """Pushes data to tile.qml over the socket Win8Start passes in
+    WIN8START_TILE_SOCKET. The last state is sent again after a reconnect,
+    so a restarted Start menu picks it up."""
+
+    def __init__(self):
+        self.path = os.environ.get("WIN8START_TILE_SOCKET")
+        self.sock = None
+        self.state = {}
+        self.image = None  # (shared memory, descriptor) of the last image
+
+    def available(self):
+        return bool(self.path)
+
+    def publish(self, **values):
+        """Set keys of the tile's liveTile.data; None removes a key."""
+        self._send(MSG_JSON, json.dumps(values).encode())
+        self.state.update(values)
+        self.state = {k: v for k, v in self.state.items() if v is not None}
+
+    def publish_image(self, name, data):
+        """Show encoded image bytes (JPEG, PNG, ...) as liveTile.data[name]."""
+        shm = shared_memory.SharedMemory(create=True, size=len(data))
+        shm.buf[:len(data)] = data
+        desc = {"name": name, "shm": shm.name, "size": len(data), "format": "encoded"}
+
+        self._send(MSG_IMAGE, json.dumps(desc).encode())
+        previous, self.image = self.image, (shm, desc)
+
+        # Copied by Start when it was sent, one update ago
+        if previous:
+            previous[0].close()
+            previous[0].unlink()
+
+    def close(self):
+        if self.image:
+            self.image[0].close()
+            self.image[0].unlink()
+            self.image = None
+
+    def _write(self, kind, payload):
+        self.sock.sendall(struct.pack("<BI", kind, len(payload)) + payload)
+
+    def _connect(self):
+        self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self.sock.connect(self.path)
+        if self.state:
+            self._write(MSG_JSON, json.dumps(self.state).encode())
+        if self.image:
+            self._write(MSG_IMAGE, json.dumps(self.image[1]).encode())
+
+    def _send(self, kind, payload):
+        try:
+            if self.sock is None:
+                self._connect()
+            self._write(kind, payload)
+        except OSError:
+            # Start is not listening (yet); the next update reconnects
+            if self.sock:
+                self.sock.close()
+            self.sock = None
+
 
 def get_current_art_url():
     """Get the current track's art URL using playerctl."""
@@ -23,56 +96,70 @@ def get_current_art_url():
         return None
 
 
-def download_thumbnail(url):
-    """Download image from URL or copy local file."""
+def fetch_thumbnail(url):
+    """Image bytes from a local file or URL, or None."""
     if url.startswith("file://"):
         # Decode URL-encoded path (%20 -> space)
         local_path = unquote(url[7:])
 
         # Ignore transient / invalid paths
-        if not local_path or local_path == "/":
-            return
+        if not local_path or local_path == "/" or not os.path.isfile(local_path):
+            return None
 
-        if os.path.isfile(local_path):
-            with open(local_path, "rb") as src, open(THUMBNAIL_FILE, "wb") as dst:
-                dst.write(src.read())
-            print("Thumbnail copied from local file.")
-        else:
-            # Silently ignore transient metadata glitches
-            pass
+        with open(local_path, "rb") as src:
+            return src.read()
 
+    try:
+        response = requests.get(url, timeout=5)
+        if response.status_code == 200:
+            return response.content
+    except Exception:
+        pass
+    return None
+
+
+def show_thumbnail(tile, data):
+    if tile.available():
+        tile.publish_image("art", data)
+        print("Thumbnail published.")
     else:
-        try:
-            response = requests.get(url, timeout=5)
-            if response.status_code == 200:
-                with open(THUMBNAIL_FILE, "wb") as f:
-                    f.write(response.content)
-                print("Thumbnail downloaded from URL.")
-        except Exception:
-            pass
+        with open(THUMBNAIL_FILE, "wb") as f:
+            f.write(data)
+        print("Thumbnail saved.")
 
 
-def remove_thumbnail():
-    if os.path.exists(THUMBNAIL_FILE):
+def remove_thumbnail(tile):
+    if tile.available():
+        tile.publish(art=None)
+    elif os.path.exists(THUMBNAIL_FILE):
         os.remove(THUMBNAIL_FILE)
-        print("No track playing. Thumbnail removed.")
+    print("No track playing. Thumbnail removed.")
 
 
 def main():
+    tile = LiveTile()
     last_art_url = None
 
-    while True:
-        art_url = get_current_art_url()
+    # Stopped by Win8Start when the tile goes away: free the shared memory
+    signal.signal(signal.SIGTERM, lambda *_: sys.exit(0))
 
-        if art_url and art_url != last_art_url:
-            download_thumbnail(art_url)
-            last_art_url = art_url
-
-        elif not art_url and last_art_url is not None:
-            remove_thumbnail()
-            last_art_url = None
-
-        time.sleep(UPDATE_INTERVAL)
+    try:
+        while True:
+            art_url = get_current_art_url()
+
+            if art_url and art_url != last_art_url:
+                data = fetch_thumbnail(art_url)
+                if data:
+                    show_thumbnail(tile, data)
+                last_art_url = art_url
+
+            elif not art_url and last_art_url is not None:
+                remove_thumbnail(tile)
+                last_art_url = None
+
+            time.sleep(UPDATE_INTERVAL)
+    finally:
+        tile.close()
 
 
 if __name__ == "__main__":
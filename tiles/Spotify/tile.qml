@@ -5,6 +5,9 @@ Item {
 	id: art
 	anchors.fill: parent
 	
+	// Set by Win8Start; logic.py publishes the cover as data.art
+	property var liveTile: null
+	
 	Rectangle {
 		anchors.fill: parent
 		color: "transparent"
@@ -14,7 +17,7 @@ Item {
 			anchors.horizontalCenter: parent.horizontalCenter
 			width: parent.width
 			height: parent.height * 1.5
-			source: Qt.resolvedUrl("art.jpg")
+			source: art.liveTile ? (art.liveTile.data.art || "") : Qt.resolvedUrl("art.jpg")
 			cache: false
 			fillMode: Image.PreserveAspectCrop
 			smooth: true
@@ -51,9 +54,10 @@ Item {
 		}
 	}
 	
+	// Older Win8Start without the live tile bus: poll the file
 	Timer {
 		interval: 1000
-		running: true
+		running: !art.liveTile
 		repeat: true
 		onTriggered: {
 			animatedImage.source = ""